@@ -0,0 +1,225 @@
+#include "Compression.h"
+
+#include <cstring>
+
+#if defined(DISPLAY_LOGS)
+#include <iostream>
+#endif
+
+namespace DataPacker
+{
+    namespace
+    {
+        /// Minimum match length allowed by the format
+        const uint32_t LZ4_MIN_MATCH = 4;
+
+        /// The last bytes of a block are always literals
+        const uint32_t LZ4_LAST_LITERALS = 5;
+
+        /// A match can't start in the last bytes of a block
+        const uint32_t LZ4_MF_LIMIT = 12;
+
+        /// Farthest reachable match
+        const uint32_t LZ4_MAX_OFFSET = 65535;
+
+        /// Match finder hash table size (log2)
+        const uint32_t LZ4_HASH_LOG = 12;
+
+        inline uint32_t Read32(const uint8_t* data) { uint32_t value; std::memcpy(&value, data, sizeof(uint32_t)); return value; }
+        inline uint32_t Hash32(uint32_t sequence) { return (sequence * 2654435761u) >> (32 - LZ4_HASH_LOG); }
+
+        /// Write a length continuation as a run of 255 finished by the remainder
+        inline void WriteLength(uint8_t*& output, uint32_t length)
+        {
+            while(length >= 255) {
+                *output++ = 255;
+                length -= 255;
+            }
+            *output++ = static_cast<uint8_t>(length);
+        }
+
+        /// Read a length continuation, returns false if the block ends too soon
+        inline bool ReadLength(const uint8_t* data, uint32_t size, uint32_t& position, uint32_t& length)
+        {
+            uint8_t value;
+            do {
+                if(position >= size) return false;
+                value = data[position++];
+                length += value;
+            } while(value == 255);
+            return true;
+        }
+    }
+
+    std::vector<char> Compression::Compress(const char* data, uint32_t size, CODEC codec)
+    {
+        if(codec != CODEC::LZ4 || data == nullptr || !size) return {};
+
+        // Worst case : incompressible data with its length continuations
+        std::vector<char> output(Compression::PAYLOAD_HEADER_SIZE + size + size / 255 + 16);
+
+        output[0] = codec;
+        std::memcpy(&output[sizeof(CODEC)], &size, sizeof(uint32_t));
+
+        uint32_t encoded_size = Compression::EncodeLZ4(reinterpret_cast<const uint8_t*>(data), size,
+                                                       reinterpret_cast<uint8_t*>(&output[Compression::PAYLOAD_HEADER_SIZE]));
+
+        // Not worth it
+        if(Compression::PAYLOAD_HEADER_SIZE + encoded_size >= size) return {};
+
+        output.resize(Compression::PAYLOAD_HEADER_SIZE + encoded_size);
+        return output;
+    }
+
+    bool Compression::ReadHeader(const char* payload, uint32_t payload_size, PAYLOAD_HEADER& header)
+    {
+        if(payload == nullptr || payload_size < Compression::PAYLOAD_HEADER_SIZE) return false;
+
+        header.codec = static_cast<CODEC>(payload[0]);
+        std::memcpy(&header.raw_size, payload + sizeof(CODEC), sizeof(uint32_t));
+
+        return header.codec == CODEC::LZ4;
+    }
+
+    bool Compression::Decompress(const char* payload, uint32_t payload_size, char* output, uint32_t output_size)
+    {
+        PAYLOAD_HEADER header;
+        if(!Compression::ReadHeader(payload, payload_size, header)) return false;
+        if(output_size < header.raw_size) return false;
+
+        return Compression::DecodeLZ4(reinterpret_cast<const uint8_t*>(payload + Compression::PAYLOAD_HEADER_SIZE),
+                                      payload_size - Compression::PAYLOAD_HEADER_SIZE,
+                                      reinterpret_cast<uint8_t*>(output), header.raw_size);
+    }
+
+    const char* Compression::Expand(const char* data, uint32_t& size, bool compressed, std::vector<char>& storage)
+    {
+        if(!compressed) return data;
+
+        PAYLOAD_HEADER header;
+        if(!Compression::ReadHeader(data, size, header)) return nullptr;
+
+        storage.resize(header.raw_size);
+        if(!header.raw_size) {
+            size = 0;
+            return data;
+        }
+
+        if(!Compression::Decompress(data, size, storage.data(), header.raw_size)) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "Compression::Expand() : corrupted payload" << std::endl;
+            #endif
+            return nullptr;
+        }
+
+        size = header.raw_size;
+        return storage.data();
+    }
+
+    uint32_t Compression::EncodeLZ4(const uint8_t* data, uint32_t size, uint8_t* output)
+    {
+        uint8_t* out = output;
+        uint32_t anchor = 0;
+
+        if(size > LZ4_MF_LIMIT) {
+
+            // Last position of the input where a match can begin
+            uint32_t match_limit = size - LZ4_MF_LIMIT;
+            uint32_t match_end_limit = size - LZ4_LAST_LITERALS;
+
+            std::vector<uint32_t> hash_table(static_cast<size_t>(1) << LZ4_HASH_LOG, UINT32_MAX);
+
+            uint32_t position = 0;
+            while(position < match_limit) {
+
+                // Look for a previous occurrence of the next four bytes
+                uint32_t sequence = Read32(data + position);
+                uint32_t& slot = hash_table[Hash32(sequence)];
+                uint32_t reference = slot;
+                slot = position;
+
+                if(reference == UINT32_MAX || position - reference > LZ4_MAX_OFFSET || Read32(data + reference) != sequence) {
+                    position++;
+                    continue;
+                }
+
+                // Extend the match
+                uint32_t match_length = LZ4_MIN_MATCH;
+                while(position + match_length < match_end_limit && data[reference + match_length] == data[position + match_length]) match_length++;
+
+                // Token
+                uint32_t literal_length = position - anchor;
+                uint8_t* token = out++;
+                *token = static_cast<uint8_t>((literal_length >= 15 ? 15 : literal_length) << 4);
+                if(literal_length >= 15) WriteLength(out, literal_length - 15);
+
+                // Literals
+                std::memcpy(out, data + anchor, literal_length);
+                out += literal_length;
+
+                // Offset, little endian
+                uint32_t offset = position - reference;
+                *out++ = static_cast<uint8_t>(offset & 0xFF);
+                *out++ = static_cast<uint8_t>(offset >> 8);
+
+                // Match length
+                uint32_t extra_length = match_length - LZ4_MIN_MATCH;
+                *token |= static_cast<uint8_t>(extra_length >= 15 ? 15 : extra_length);
+                if(extra_length >= 15) WriteLength(out, extra_length - 15);
+
+                position += match_length;
+                anchor = position;
+            }
+        }
+
+        // Last literals
+        uint32_t literal_length = size - anchor;
+        uint8_t* token = out++;
+        *token = static_cast<uint8_t>((literal_length >= 15 ? 15 : literal_length) << 4);
+        if(literal_length >= 15) WriteLength(out, literal_length - 15);
+        std::memcpy(out, data + anchor, literal_length);
+        out += literal_length;
+
+        return static_cast<uint32_t>(out - output);
+    }
+
+    bool Compression::DecodeLZ4(const uint8_t* data, uint32_t size, uint8_t* output, uint32_t output_size)
+    {
+        uint32_t position = 0;
+        uint32_t written = 0;
+
+        while(position < size) {
+
+            uint8_t token = data[position++];
+
+            // Literals
+            uint32_t literal_length = token >> 4;
+            if(literal_length == 15 && !ReadLength(data, size, position, literal_length)) return false;
+            if(literal_length > size - position || literal_length > output_size - written) return false;
+            std::memcpy(output + written, data + position, literal_length);
+            position += literal_length;
+            written += literal_length;
+
+            // The last sequence only holds literals
+            if(position == size) break;
+
+            // Offset
+            if(position + 2 > size) return false;
+            uint32_t offset = data[position] | (data[position + 1] << 8);
+            position += 2;
+            if(!offset || offset > written) return false;
+
+            // Match, may overlap the bytes it is writing
+            uint32_t match_length = token & 0x0F;
+            if(match_length == 15 && !ReadLength(data, size, position, match_length)) return false;
+            match_length += LZ4_MIN_MATCH;
+            if(match_length > output_size - written) return false;
+
+            const uint8_t* match = output + written - offset;
+            for(uint32_t i=0; i<match_length; i++) output[written + i] = match[i];
+            written += match_length;
+        }
+
+        return written == output_size;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace DataPacker
+{
+    /**
+     * Block compression of node data.
+     * A compressed payload starts with its codec and the decompressed size, followed by the encoded block.
+     */
+    class Compression
+    {
+        public :
+
+            enum CODEC : uint8_t
+            {
+                NONE    = 0,    // Data stored as is
+                LZ4     = 1     // LZ4 block format
+            };
+
+            /// Compressed payload header
+            struct PAYLOAD_HEADER
+            {
+                /// Codec used to encode the block
+                CODEC codec;
+
+                /// Decompressed data size
+                uint32_t raw_size;
+            };
+
+            /// Serialized payload header size
+            static const uint32_t PAYLOAD_HEADER_SIZE = sizeof(CODEC) + sizeof(uint32_t);
+
+            /**
+             * Compress a data block
+             * @param data Data to compress
+             * @param size Data size
+             * @param codec Codec to use
+             * @return Compressed payload, empty if the codec is unknown or if compression does not reduce the size
+             */
+            static std::vector<char> Compress(const char* data, uint32_t size, CODEC codec);
+
+            /**
+             * Read the header of a compressed payload
+             * @param payload Compressed payload
+             * @param payload_size Compressed payload size
+             * @param header Filled with payload informations
+             * @retval true Header is valid
+             * @retval false Payload is too small or codec is unknown
+             */
+            static bool ReadHeader(const char* payload, uint32_t payload_size, PAYLOAD_HEADER& header);
+
+            /**
+             * Decompress a payload inside a caller provided buffer
+             * @param payload Compressed payload
+             * @param payload_size Compressed payload size
+             * @param output Destination buffer
+             * @param output_size Destination buffer size, must be at least the decompressed size
+             * @retval true Success
+             * @retval false Corrupted payload or destination buffer too small
+             */
+            static bool Decompress(const char* payload, uint32_t payload_size, char* output, uint32_t output_size);
+
+            /**
+             * Get node data ready to use
+             * @param data Stored node data
+             * @param size Stored size as input, usable size as output
+             * @param compressed Node data is a compressed payload
+             * @param storage Decompression buffer, untouched when data is not compressed
+             * @return Pointer to usable data, nullptr in case of failure
+             */
+            static const char* Expand(const char* data, uint32_t& size, bool compressed, std::vector<char>& storage);
+
+        private :
+
+            /**
+             * Encode a block with LZ4 block format
+             * @param data Data to encode
+             * @param size Data size
+             * @param output Destination buffer, large enough for the worst case
+             * @return Encoded size
+             */
+            static uint32_t EncodeLZ4(const uint8_t* data, uint32_t size, uint8_t* output);
+
+            /**
+             * Decode a LZ4 block
+             * @param data Encoded block
+             * @param size Encoded block size
+             * @param output Destination buffer
+             * @param output_size Expected decoded size
+             * @retval true Success
+             * @retval false Corrupted block
+             */
+            static bool DecodeLZ4(const uint8_t* data, uint32_t size, uint8_t* output, uint32_t output_size);
+
+            /// Compression is not instanciable
+            Compression() = delete;
+    };
+}
\ No newline at end of file
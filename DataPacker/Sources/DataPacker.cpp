@@ -1,4 +1,6 @@
 #include "DataPacker.h"
+#include "MappedPackage.h"
+#include "PackageIndex.h"
 
 namespace DataPacker
 {
@@ -6,12 +8,14 @@ namespace DataPacker
     {
         if(&other != this) {
             this->type = other.type;
+            this->compressed = other.compressed;
             this->size = other.size;
             this->position = other.position;
             this->name = std::move(other.name);
             this->dependancies = std::move(other.dependancies);
             this->children = std::move(other.children);
             other.type = DATA_TYPE::UNDEFINED;
+            other.compressed = false;
             other.size = 0;
             other.position = 0;
         }
@@ -23,6 +27,7 @@ namespace DataPacker
     {
         if(this != &other) {
             this->type = other.type;
+            this->compressed = other.compressed;
             this->size = other.size;
             this->position = other.position;
             this->name = other.name;
@@ -37,7 +42,8 @@ namespace DataPacker
         std::vector<char> output;
         
         // Type
-        output.insert(output.end(), &this->type, &this->type + sizeof(DATA_TYPE));
+        uint8_t type = this->compressed ? this->type | Packer::COMPRESSED_NODE : this->type;
+        output.push_back(static_cast<char>(type));
 
         // Name
         uint8_t name_length = static_cast<uint8_t>(this->name.size());
@@ -67,20 +73,44 @@ namespace DataPacker
     }
 
     std::vector<Packer::DATA> Packer::UnpackMemory(std::vector<char> const& memory, uint32_t position, uint32_t size)
+    {
+        return Packer::UnpackMemory(memory.data(), memory.size(), position, size);
+    }
+
+    std::vector<Packer::DATA> Packer::UnpackMemory(MappedPackage const& package, uint32_t position, uint32_t size)
+    {
+        return Packer::UnpackMemory(package.Data(), package.Size(), position, size);
+    }
+
+    std::vector<Packer::DATA> Packer::UnpackMemory(const char* memory, size_t memory_size, uint32_t position, uint32_t size)
     {
         std::vector<DATA> package;
 
         uint32_t final_position;
-        if(!position && !size && memory.size() > 0) final_position = static_cast<uint32_t>(memory.size());
-        else final_position = position + size;
+        if(!position && !size && memory_size > 0) {
+
+            // Skip package file header and table of contents
+            if(Packer::IsPackageFile(memory, memory_size)) {
+                FILE_HEADER const* header = Packer::GetFileHeader(memory, memory_size);
+                if(header == nullptr) return package;
+                position = header->body_offset;
+                final_position = header->body_offset + header->body_size;
+            }else{
+                final_position = static_cast<uint32_t>(memory_size);
+            }
+        }else{
+            final_position = position + size;
+        }
         
         while(position < final_position) {
 
             // Store node position
             uint32_t node_position = position;
             
-            // First byte = Type
-            DATA_TYPE type = static_cast<DATA_TYPE>(memory[position]);
+            // First byte = Type, with compression flag
+            uint8_t type_byte = static_cast<uint8_t>(memory[position]);
+            DATA_TYPE type = static_cast<DATA_TYPE>(type_byte & ~Packer::COMPRESSED_NODE);
+            bool compressed = (type_byte & Packer::COMPRESSED_NODE) != 0;
             position++;
 
             // Name length
@@ -89,7 +119,7 @@ namespace DataPacker
 
             // Name
             std::string name;
-            if(name_length > 0) name = std::string(memory.begin() + position, memory.begin() + position + name_length);
+            if(name_length > 0) name = std::string(memory + position, memory + position + name_length);
             position += name_length;
 
             // Dependancy count
@@ -102,21 +132,21 @@ namespace DataPacker
                 uint8_t dependancy_length = memory[position];
                 position++;
                 if(dependancy_length > 0) {
-                    dependancies.push_back(std::string(memory.begin() + position, memory.begin() + position + dependancy_length));
+                    dependancies.push_back(std::string(memory + position, memory + position + dependancy_length));
                     position += dependancy_length;
                 }
             }
 
             // Data size
-            uint32_t data_size = *reinterpret_cast<const uint32_t*>(&memory[position]);
+            uint32_t data_size = *reinterpret_cast<const uint32_t*>(memory + position);
             position += sizeof(uint32_t);
 
             // Unpack child nodes
             std::vector<DATA> children;
-            if(Packer::IsContainer(type)) children = Packer::UnpackMemory(memory, position, data_size);
+            if(Packer::IsContainer(type)) children = Packer::UnpackMemory(memory, memory_size, position, data_size);
 
             // Add unpacked data to result vector
-            package.push_back({type, data_size, node_position, name, dependancies, children});
+            package.push_back({type, data_size, node_position, name, dependancies, children, compressed});
 
             // Unpack next node
             position += data_size;
@@ -125,6 +155,67 @@ namespace DataPacker
         return package;
     }
 
+    Packer::FILE_HEADER const* Packer::GetFileHeader(const char* memory, size_t size)
+    {
+        if(!Packer::IsPackageFile(memory, size)) return nullptr;
+
+        FILE_HEADER const* header = reinterpret_cast<FILE_HEADER const*>(memory);
+        size_t toc_size = header->entry_count * sizeof(TOC_ENTRY) + header->dependancy_count * sizeof(uint32_t);
+
+        if(header->version > Packer::FILE_VERSION
+           || header->body_offset < sizeof(FILE_HEADER) + toc_size
+           || static_cast<size_t>(header->body_offset) + header->body_size > size) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "Packer::GetFileHeader() : unsupported or corrupted package file" << std::endl;
+            #endif
+            return nullptr;
+        }
+
+        return header;
+    }
+
+    std::vector<char> Packer::BuildPackageFile(std::vector<char> const& body)
+    {
+        // Index the node tree, its entries come out sorted by path hash
+        PackageIndex index;
+        if(!index.Build(body)) return {};
+        std::vector<TOC_ENTRY> entries = index.GetEntries();
+        std::vector<uint32_t> const& dependancies = index.GetDependancies();
+
+        FILE_HEADER header;
+        header.signature = Packer::FILE_SIGNATURE;
+        header.version = Packer::FILE_VERSION;
+        header.entry_count = static_cast<uint32_t>(entries.size());
+        header.dependancy_count = static_cast<uint32_t>(dependancies.size());
+        header.body_offset = static_cast<uint32_t>(sizeof(FILE_HEADER) + entries.size() * sizeof(TOC_ENTRY) + dependancies.size() * sizeof(uint32_t));
+        header.body_size = static_cast<uint32_t>(body.size());
+
+        // Node positions become relative to the beginning of the file
+        for(auto& entry : entries) entry.offset += header.body_offset;
+
+        std::vector<char> file(header.body_offset + body.size());
+        char* output = file.data();
+        std::memcpy(output, &header, sizeof(FILE_HEADER));
+        output += sizeof(FILE_HEADER);
+        if(!entries.empty()) std::memcpy(output, entries.data(), entries.size() * sizeof(TOC_ENTRY));
+        output += entries.size() * sizeof(TOC_ENTRY);
+        if(!dependancies.empty()) std::memcpy(output, dependancies.data(), dependancies.size() * sizeof(uint32_t));
+        output += dependancies.size() * sizeof(uint32_t);
+        if(!body.empty()) std::memcpy(output, body.data(), body.size());
+
+        return file;
+    }
+
+    std::vector<char> Packer::ExtractPackageBody(std::vector<char> const& file)
+    {
+        if(!Packer::IsPackageFile(file.data(), file.size())) return file;
+
+        FILE_HEADER const* header = Packer::GetFileHeader(file.data(), file.size());
+        if(header == nullptr) return {};
+
+        return std::vector<char>(file.begin() + header->body_offset, file.begin() + header->body_offset + header->body_size);
+    }
+
     bool Packer::PackToMemory(std::vector<char>& memory, std::string const& path, DATA_TYPE const type,
                               std::string const& name, std::unique_ptr<char> const& data, uint32_t data_size,
                               std::vector<std::string> dependancies)
@@ -257,8 +348,8 @@ namespace DataPacker
         // Find data in table
         DATA& pack = Packer::FindPackedItem(package, path);
 
-        // Change type
-        memory[pack.position] = type;
+        // Change type, compression flag is kept
+        memory[pack.position] = static_cast<char>(pack.compressed ? type | Packer::COMPRESSED_NODE : type);
     }
 
     void Packer::RemoveNode(std::vector<char>& memory, std::string const& path)
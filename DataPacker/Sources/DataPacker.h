@@ -2,11 +2,14 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include <Tools.h>
 #include "../../Maths/Sources/Maths.h"
 
 namespace DataPacker
 {
+    class MappedPackage;
+
     class Packer
     {
         public :
@@ -22,14 +25,24 @@ namespace DataPacker
                 IMAGE_FILE      = 6,
                 MESH_DATA       = 7,
                 MATERIAL_DATA   = 8,
-                MODEL_TREE      = 9
+                MODEL_TREE      = 9,
+                MESH_VBO        = 10
             };
             
+            /// Type byte flag marking a node whose data is a compressed payload (see Compression)
+            static const uint8_t COMPRESSED_NODE = 0x80;
+
+            /// Table of contents flag marking a compressed node
+            static const uint16_t TOC_COMPRESSED = 0x0001;
+
             struct DATA
             {
                 /// Data type
                 DATA_TYPE type;
 
+                /// Data is a compressed payload
+                bool compressed;
+
                 /// Data size
                 uint32_t size;
 
@@ -46,13 +59,13 @@ namespace DataPacker
                 std::vector<DATA> children;
 
                 /// Initialize to empty data
-                DATA() : type(DATA_TYPE::UNDEFINED), size(0), position(0) {}
+                DATA() : type(DATA_TYPE::UNDEFINED), compressed(false), size(0), position(0) {}
 
                 /// Copy constructor
-                DATA(DATA const& other) : type(other.type), size(other.size), position(other.position), name(other.name), dependancies(other.dependancies), children(other.children) {}
+                DATA(DATA const& other) : type(other.type), compressed(other.compressed), size(other.size), position(other.position), name(other.name), dependancies(other.dependancies), children(other.children) {}
 
                 /// Explicit values constructor
-                DATA(DATA_TYPE type, uint32_t size, uint32_t position, std::string const& name, std::vector<std::string> dependancies, std::vector<DATA> const& children) : type(type), size(size), position(position), name(name), dependancies(dependancies), children(children) {}
+                DATA(DATA_TYPE type, uint32_t size, uint32_t position, std::string const& name, std::vector<std::string> dependancies, std::vector<DATA> const& children, bool compressed = false) : type(type), compressed(compressed), size(size), position(position), name(name), dependancies(dependancies), children(children) {}
                 
                 /// Move constructor
                 DATA(DATA&& other) { *this = std::move(other); }
@@ -76,6 +89,102 @@ namespace DataPacker
                 inline const char* Data(const char* buffer) { return buffer + this->position + this->HeaderSize(); }
             };
 
+            /// Current package file format version
+            static const uint32_t FILE_VERSION = 2;
+
+            /// Package file signature ("KEAP"), its first byte can't be mistaken for a legacy node type
+            static const uint32_t FILE_SIGNATURE = 0x5041454B;
+
+            /// Dependancy index used when the dependancy path doesn't exist in the package
+            static const uint32_t UNRESOLVED_DEPENDANCY = 0xFFFFFFFF;
+
+            /**
+             * Fixed size header found at the beginning of a package file.
+             * It is followed by the table of contents, the dependancy indices and finally the node tree.
+             * Files without this header are read as legacy packages made of the node tree only.
+             */
+            struct FILE_HEADER
+            {
+                /// Must be FILE_SIGNATURE
+                uint32_t signature;
+
+                /// Format version
+                uint32_t version;
+
+                /// Number of TOC_ENTRY following the header
+                uint32_t entry_count;
+
+                /// Number of dependancy indices following the table of contents
+                uint32_t dependancy_count;
+
+                /// Node tree first byte position
+                uint32_t body_offset;
+
+                /// Node tree size
+                uint32_t body_size;
+            };
+
+            /**
+             * Table of contents entry, one per node, sorted by path hash
+             */
+            struct TOC_ENTRY
+            {
+                /// Hash of the node full path
+                uint64_t hash;
+
+                /// Data first byte position, from the beginning of the file
+                uint32_t offset;
+
+                /// Data size
+                uint32_t size;
+
+                /// Position of the first dependancy in the dependancy indices array
+                uint32_t first_dependancy;
+
+                /// Number of dependancies
+                uint8_t dependancy_count;
+
+                /// Data type
+                DATA_TYPE type;
+
+                /// Node options (TOC_COMPRESSED)
+                uint16_t flags;
+
+                /// Get a pointer on the target buffer
+                inline const char* Data(const char* buffer) const { return buffer + this->offset; }
+            };
+
+            /**
+             * Build a complete package file (header, table of contents and node tree) from a node tree
+             * @param body Node tree, as produced by PackToMemory()
+             * @return File content, empty if two node paths share the same hash
+             */
+            static std::vector<char> BuildPackageFile(std::vector<char> const& body);
+
+            /**
+             * Get the node tree of a package file, legacy files are returned unchanged
+             * @param file File content
+             * @return Node tree, editable with PackToMemory(), RemoveNode(), etc.
+             */
+            static std::vector<char> ExtractPackageBody(std::vector<char> const& file);
+
+            /**
+             * Determines if a buffer starts with a package file signature
+             * @param memory First byte of the buffer
+             * @param size Buffer size
+             * @retval true Buffer starts with a FILE_HEADER
+             * @retval false Buffer is a legacy package
+             */
+            static inline bool IsPackageFile(const char* memory, size_t size) { return size >= sizeof(FILE_HEADER) && *reinterpret_cast<const uint32_t*>(memory) == FILE_SIGNATURE; }
+
+            /**
+             * Get the header of a package file after checking its consistency
+             * @param memory First byte of the file
+             * @param size File size
+             * @return Pointer to the header, nullptr for legacy, unsupported or corrupted files
+             */
+            static FILE_HEADER const* GetFileHeader(const char* memory, size_t size);
+
             /**
              * Extract data table from raw buffer
              * @param memory Data buffer
@@ -85,6 +194,25 @@ namespace DataPacker
              */
             static std::vector<DATA> UnpackMemory(std::vector<char> const& memory, uint32_t position = 0, uint32_t size = 0);
 
+            /**
+             * Extract data table from a memory mapped package, DATA::Data() then points inside the mapping
+             * @param package Mapped package
+             * @param position Parse data from this position
+             * @param size Amount of data to parse, if size = 0 for no limit
+             * @return Data table
+             */
+            static std::vector<DATA> UnpackMemory(MappedPackage const& package, uint32_t position = 0, uint32_t size = 0);
+
+            /**
+             * Extract data table from raw memory
+             * @param memory First byte of the package
+             * @param memory_size Package size
+             * @param position Parse data from this position
+             * @param size Amount of data to parse, if size = 0 for no limit
+             * @return Data table
+             */
+            static std::vector<DATA> UnpackMemory(const char* memory, size_t memory_size, uint32_t position = 0, uint32_t size = 0);
+
             /**
              * Insert serialized data inside a packaged data buffer
              * @param memory Data buffer
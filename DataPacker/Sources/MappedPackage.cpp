@@ -0,0 +1,158 @@
+#include "MappedPackage.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace DataPacker
+{
+    MappedPackage::MappedPackage()
+    {
+        this->data = nullptr;
+        this->size = 0;
+
+        #if defined(_WIN32)
+        this->file = INVALID_HANDLE_VALUE;
+        this->mapping = nullptr;
+        #endif
+    }
+
+    MappedPackage::MappedPackage(std::string const& filename) : MappedPackage()
+    {
+        this->Open(filename);
+    }
+
+    MappedPackage::~MappedPackage()
+    {
+        this->Close();
+    }
+
+    MappedPackage::MappedPackage(MappedPackage&& other) : MappedPackage()
+    {
+        *this = std::move(other);
+    }
+
+    MappedPackage& MappedPackage::operator=(MappedPackage&& other)
+    {
+        if(&other != this) {
+            this->Close();
+
+            this->data = other.data;
+            this->size = other.size;
+            this->index = std::move(other.index);
+            other.data = nullptr;
+            other.size = 0;
+            other.index.Clear();
+
+            #if defined(_WIN32)
+            this->file = other.file;
+            this->mapping = other.mapping;
+            other.file = INVALID_HANDLE_VALUE;
+            other.mapping = nullptr;
+            #endif
+        }
+
+        return *this;
+    }
+
+    bool MappedPackage::Open(std::string const& filename)
+    {
+        this->Close();
+
+        #if defined(_WIN32)
+        this->file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(this->file == INVALID_HANDLE_VALUE) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "MappedPackage::Open(\"" << filename << "\") : CreateFile failed" << std::endl;
+            #endif
+            return false;
+        }
+
+        LARGE_INTEGER file_size;
+        if(!GetFileSizeEx(this->file, &file_size) || file_size.QuadPart == 0) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "MappedPackage::Open(\"" << filename << "\") : empty file" << std::endl;
+            #endif
+            this->Close();
+            return false;
+        }
+
+        this->mapping = CreateFileMappingA(this->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if(this->mapping == nullptr) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "MappedPackage::Open(\"" << filename << "\") : CreateFileMapping failed" << std::endl;
+            #endif
+            this->Close();
+            return false;
+        }
+
+        this->data = static_cast<const char*>(MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0));
+        if(this->data == nullptr) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "MappedPackage::Open(\"" << filename << "\") : MapViewOfFile failed" << std::endl;
+            #endif
+            this->Close();
+            return false;
+        }
+
+        this->size = static_cast<size_t>(file_size.QuadPart);
+        #else
+        int file = open(filename.c_str(), O_RDONLY);
+        if(file < 0) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "MappedPackage::Open(\"" << filename << "\") : open failed" << std::endl;
+            #endif
+            return false;
+        }
+
+        struct stat file_stat;
+        if(fstat(file, &file_stat) < 0 || file_stat.st_size == 0) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "MappedPackage::Open(\"" << filename << "\") : empty file" << std::endl;
+            #endif
+            close(file);
+            return false;
+        }
+
+        // The mapping stays valid once the descriptor is closed
+        void* mapped = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        close(file);
+        if(mapped == MAP_FAILED) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "MappedPackage::Open(\"" << filename << "\") : mmap failed" << std::endl;
+            #endif
+            return false;
+        }
+
+        this->data = static_cast<const char*>(mapped);
+        this->size = static_cast<size_t>(file_stat.st_size);
+        #endif
+
+        if(!this->index.Build(this->data, this->size)) {
+            this->Close();
+            return false;
+        }
+
+        return true;
+    }
+
+    void MappedPackage::Close()
+    {
+        #if defined(_WIN32)
+        if(this->data != nullptr) UnmapViewOfFile(this->data);
+        if(this->mapping != nullptr) CloseHandle(this->mapping);
+        if(this->file != INVALID_HANDLE_VALUE) CloseHandle(this->file);
+        this->mapping = nullptr;
+        this->file = INVALID_HANDLE_VALUE;
+        #else
+        if(this->data != nullptr) munmap(const_cast<char*>(this->data), this->size);
+        #endif
+
+        this->data = nullptr;
+        this->size = 0;
+        this->index.Clear();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "DataPacker.h"
+#include "PackageIndex.h"
+
+namespace DataPacker
+{
+    /**
+     * Read-only package mapped in memory.
+     * The file is never copied : nodes are read straight from the mapping and the
+     * operating system only loads the pages that are actually accessed.
+     * Pointers obtained with Data() or DATA::Data() remain valid until the package is closed.
+     */
+    class MappedPackage
+    {
+        public :
+
+            /// Empty package
+            MappedPackage();
+
+            /// Open and map a package file
+            MappedPackage(std::string const& filename);
+
+            /// Unmap file
+            ~MappedPackage();
+
+            /// Copy is forbidden, the mapping has only one owner
+            MappedPackage(MappedPackage const&) = delete;
+            MappedPackage& operator=(MappedPackage const&) = delete;
+
+            /// Move constructor
+            MappedPackage(MappedPackage&& other);
+
+            /// Move assignment
+            MappedPackage& operator=(MappedPackage&& other);
+
+            /**
+             * Map a package file in memory and build its index, previous mapping is released
+             * @param filename Package file path
+             * @retval true Success
+             * @retval false Failure, the package is left empty
+             */
+            bool Open(std::string const& filename);
+
+            /// Release the mapping
+            void Close();
+
+            /// Determines if a file is currently mapped
+            inline bool IsOpen() const { return this->data != nullptr; }
+
+            /// Get a pointer on the first byte of the package
+            inline const char* Data() const { return this->data; }
+
+            /// Package size in bytes
+            inline size_t Size() const { return this->size; }
+
+            /// Get the index of the package nodes
+            inline PackageIndex const& Index() const { return this->index; }
+
+        private :
+
+            /// Mapped data
+            const char* data;
+
+            /// Mapped size
+            size_t size;
+
+            /// Nodes lookup table
+            PackageIndex index;
+
+            #if defined(_WIN32)
+            /// File handle
+            HANDLE file;
+
+            /// File mapping handle
+            HANDLE mapping;
+            #endif
+    };
+}
\ No newline at end of file
@@ -0,0 +1,335 @@
+#include "Package.h"
+
+namespace DataPacker
+{
+    Package::NODE* Package::NODE::FindChild(std::string const& child_name) const
+    {
+        auto child = this->children_by_name.find(child_name);
+        if(child == this->children_by_name.end()) return nullptr;
+        return child->second;
+    }
+
+    uint32_t Package::NODE::SerializedSize() const
+    {
+        uint32_t header_size = static_cast<uint32_t>(sizeof(Packer::DATA_TYPE) + sizeof(uint8_t) + this->name.size() + sizeof(uint8_t) + sizeof(uint32_t));
+        for(auto const& dependancy : this->dependancies) header_size += static_cast<uint32_t>(sizeof(uint8_t) + dependancy.size());
+
+        if(!Packer::IsContainer(this->type)) return header_size + this->size;
+
+        uint32_t content_size = 0;
+        for(auto const& child : this->children) content_size += child->SerializedSize();
+        return header_size + content_size;
+    }
+
+    Package::Package()
+    {
+        this->root.type = Packer::DATA_TYPE::ROOT_NODE;
+    }
+
+    void Package::Clear()
+    {
+        this->root.children.clear();
+        this->root.children_by_name.clear();
+        this->buffers.clear();
+    }
+
+    bool Package::Load(std::vector<char> memory)
+    {
+        this->Clear();
+
+        if(Packer::IsPackageFile(memory.data(), memory.size())) memory = Packer::ExtractPackageBody(memory);
+        if(memory.empty()) return true;
+
+        this->buffers.push_back(std::unique_ptr<std::vector<char>>(new std::vector<char>(std::move(memory))));
+        std::vector<char> const& buffer = *this->buffers.back();
+        if(!this->ParseNodes(this->root, buffer.data(), static_cast<uint32_t>(buffer.size()))) {
+            this->Clear();
+            return false;
+        }
+
+        return true;
+    }
+
+    bool Package::ParseNodes(NODE& parent, const char* memory, uint32_t size)
+    {
+        uint32_t position = 0;
+        while(position < size) {
+
+            std::unique_ptr<NODE> node(new NODE);
+
+            // Type, with compression flag
+            uint8_t type_byte = static_cast<uint8_t>(memory[position]);
+            node->type = static_cast<Packer::DATA_TYPE>(type_byte & ~Packer::COMPRESSED_NODE);
+            bool compressed = (type_byte & Packer::COMPRESSED_NODE) != 0;
+            position++;
+
+            // Name
+            uint8_t name_length = memory[position];
+            position++;
+            if(name_length > 0) node->name = std::string(memory + position, memory + position + name_length);
+            position += name_length;
+
+            // Dependancies
+            uint8_t dependancy_count = memory[position];
+            position++;
+            for(uint8_t i=0; i<dependancy_count; i++) {
+                uint8_t dependancy_length = memory[position];
+                position++;
+                if(dependancy_length > 0) {
+                    node->dependancies.push_back(std::string(memory + position, memory + position + dependancy_length));
+                    position += dependancy_length;
+                }
+            }
+
+            // Data size
+            uint32_t data_size = *reinterpret_cast<const uint32_t*>(memory + position);
+            position += sizeof(uint32_t);
+
+            // Containers hold nodes, other types hold a span on their data
+            if(Packer::IsContainer(node->type)) {
+                if(!this->ParseNodes(*node, memory + position, data_size)) return false;
+            }else if(compressed) {
+                std::unique_ptr<std::vector<char>> expanded(new std::vector<char>);
+                uint32_t expanded_size = data_size;
+                const char* expanded_data = Compression::Expand(memory + position, expanded_size, true, *expanded);
+                if(expanded_data == nullptr) {
+                    #if defined(DISPLAY_LOGS)
+                    std::cout << "Package::ParseNodes() : unable to decompress [" << node->name << "]" << std::endl;
+                    #endif
+                    return false;
+                }
+                node->data = expanded_data;
+                node->size = expanded_size;
+                node->buffer = std::move(expanded);
+            }else{
+                node->data = memory + position;
+                node->size = data_size;
+            }
+
+            Package::AttachNode(parent, std::move(node));
+            position += data_size;
+        }
+
+        return true;
+    }
+
+    Package::NODE* Package::AttachNode(NODE& parent, std::unique_ptr<NODE> child)
+    {
+        NODE* node = child.get();
+        node->parent = &parent;
+        parent.children_by_name.emplace(node->name, node);
+        parent.children.push_back(std::move(child));
+        return node;
+    }
+
+    std::unique_ptr<Package::NODE> Package::DetachNode(NODE& node)
+    {
+        NODE& parent = *node.parent;
+
+        auto named = parent.children_by_name.find(node.name);
+        if(named != parent.children_by_name.end() && named->second == &node) parent.children_by_name.erase(named);
+
+        std::unique_ptr<NODE> detached;
+        for(auto it = parent.children.begin(); it != parent.children.end(); ++it) {
+            if(it->get() == &node) {
+                detached = std::move(*it);
+                parent.children.erase(it);
+                break;
+            }
+        }
+
+        detached->parent = nullptr;
+        return detached;
+    }
+
+    Package::NODE* Package::FindNode(std::string const& path) const
+    {
+        NODE* node = const_cast<NODE*>(&this->root);
+
+        size_t start = 0;
+        while(node != nullptr && start < path.size()) {
+            size_t end = path.find_first_of('/', start);
+            if(end == std::string::npos) end = path.size();
+            if(end > start) node = node->FindChild(path.substr(start, end - start));
+            start = end + 1;
+        }
+
+        return node;
+    }
+
+    std::vector<char> Package::Serialize() const
+    {
+        // Compression only reduces the final size
+        uint32_t raw_size = 0;
+        for(auto const& child : this->root.children) raw_size += child->SerializedSize();
+
+        std::vector<char> output;
+        output.reserve(raw_size);
+        for(auto const& child : this->root.children) this->WriteNode(*child, output);
+
+        return output;
+    }
+
+    void Package::WriteNode(NODE const& node, std::vector<char>& output) const
+    {
+        // Type
+        size_t type_position = output.size();
+        output.push_back(static_cast<char>(node.type));
+
+        // Name
+        output.push_back(static_cast<char>(node.name.size()));
+        output.insert(output.end(), node.name.begin(), node.name.end());
+
+        // Dependancies
+        output.push_back(static_cast<char>(node.dependancies.size()));
+        for(auto const& dependancy : node.dependancies) {
+            output.push_back(static_cast<char>(dependancy.size()));
+            output.insert(output.end(), dependancy.begin(), dependancy.end());
+        }
+
+        // Data size is written once the content is known
+        size_t size_position = output.size();
+        output.resize(output.size() + sizeof(uint32_t));
+
+        if(Packer::IsContainer(node.type)) {
+            for(auto const& child : node.children) this->WriteNode(*child, output);
+
+        }else if(node.size > 0) {
+            auto codec = this->compression.find(node.type);
+            std::vector<char> payload;
+            if(codec != this->compression.end()) payload = Compression::Compress(node.data, node.size, codec->second);
+
+            if(!payload.empty()) {
+                output[type_position] = static_cast<char>(node.type | Packer::COMPRESSED_NODE);
+                output.insert(output.end(), payload.begin(), payload.end());
+            }else{
+                output.insert(output.end(), node.data, node.data + node.size);
+            }
+        }
+
+        uint32_t content_size = static_cast<uint32_t>(output.size() - size_position - sizeof(uint32_t));
+        std::memcpy(&output[size_position], &content_size, sizeof(uint32_t));
+    }
+
+    bool Package::PackToMemory(std::string const& path, Packer::DATA_TYPE const type,
+                               std::string const& name, std::unique_ptr<char> const& data, uint32_t data_size,
+                               std::vector<std::string> dependancies)
+    {
+        // Only PARENT_NODE or ROOT_NODE can contain data
+        NODE* parent = this->FindNode(path);
+        if(parent == nullptr || (parent->type != Packer::DATA_TYPE::PARENT_NODE && parent->type != Packer::DATA_TYPE::ROOT_NODE)) return false;
+
+        // Name must be unique in the same directory
+        if(parent->FindChild(name) != nullptr) return false;
+
+        std::unique_ptr<NODE> node(new NODE);
+        node->type = type;
+        node->name = name;
+        node->dependancies = std::move(dependancies);
+
+        // Keep a copy of inserted data, a container also keeps the buffer its children point to
+        if(data_size > 0) {
+            node->buffer = std::unique_ptr<std::vector<char>>(new std::vector<char>(data.get(), data.get() + data_size));
+            const char* buffer = node->buffer->data();
+
+            if(Packer::IsContainer(type)) {
+                if(!this->ParseNodes(*node, buffer, data_size)) return false;
+            }else{
+                node->data = buffer;
+                node->size = data_size;
+            }
+        }
+
+        Package::AttachNode(*parent, std::move(node));
+        return true;
+    }
+
+    bool Package::SetNodeName(std::string const& path, std::string const& name)
+    {
+        NODE* node = this->FindNode(path);
+        if(node == nullptr || node->parent == nullptr) return false;
+        if(node->name == name) return true;
+        if(node->parent->FindChild(name) != nullptr) return false;
+
+        node->parent->children_by_name.erase(node->name);
+        node->name = name;
+        node->parent->children_by_name.emplace(node->name, node);
+        return true;
+    }
+
+    void Package::RemoveNode(std::string const& path)
+    {
+        NODE* node = this->FindNode(path);
+        if(node == nullptr) return;
+
+        // If path is root, just clear all data
+        if(node->parent == nullptr) {
+            this->Clear();
+            return;
+        }
+
+        // Buffers owned by the node and its children are released with them
+        Package::DetachNode(*node);
+    }
+
+    bool Package::MoveNode(std::string const& source_path, std::string const& dest_path)
+    {
+        NODE* source = this->FindNode(source_path);
+        NODE* dest = this->FindNode(dest_path);
+
+        // Root cannot be moved and destination must be a container
+        if(source == nullptr || source->parent == nullptr || dest == nullptr || !Packer::IsContainer(dest->type)) return false;
+
+        // The node is moved to its own container
+        if(source->parent == dest) return false;
+
+        // A node cannot be moved to its subtree
+        for(NODE* ancestor = dest; ancestor != nullptr; ancestor = ancestor->parent)
+            if(ancestor == source) return false;
+
+        // Name already exist in target directory
+        if(dest->FindChild(source->name) != nullptr) return false;
+
+        Package::AttachNode(*dest, Package::DetachNode(*source));
+        return true;
+    }
+
+    Packer::DATA_TYPE Package::GetNodeType(std::string const& path) const
+    {
+        NODE const* node = this->FindNode(path);
+        if(node == nullptr) return Packer::DATA_TYPE::UNDEFINED;
+        return node->type;
+    }
+
+    void Package::SetNodeType(std::string const& path, Packer::DATA_TYPE type)
+    {
+        NODE* node = this->FindNode(path);
+        if(node == nullptr || node->parent == nullptr) return;
+
+        // Containers and data nodes are not stored the same way
+        if(Packer::IsContainer(node->type) != Packer::IsContainer(type)) return;
+
+        node->type = type;
+    }
+
+    void Package::SetNodeDependancy(std::string const& path, uint8_t index, std::string const& value)
+    {
+        NODE* node = this->FindNode(path);
+        if(node == nullptr || index >= node->dependancies.size()) return;
+        node->dependancies[index] = value;
+    }
+
+    void Package::FixDependancies(std::string const& old_path, std::string const& new_path)
+    {
+        Package::FixDependancies(this->root, old_path, new_path);
+    }
+
+    void Package::FixDependancies(NODE& node, std::string const& old_path, std::string const& new_path)
+    {
+        for(auto& dependancy : node.dependancies)
+            if(dependancy.size() >= old_path.size() && dependancy.compare(0, old_path.size(), old_path) == 0)
+                dependancy = new_path + dependancy.substr(old_path.size());
+
+        for(auto& child : node.children) Package::FixDependancies(*child, old_path, new_path);
+    }
+}
\ No newline at end of file
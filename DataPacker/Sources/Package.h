@@ -0,0 +1,229 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include "DataPacker.h"
+#include "Compression.h"
+
+namespace DataPacker
+{
+    /**
+     * Editable package held in memory as a tree of nodes.
+     * Node data is never moved : each node keeps a span on the buffer it comes from,
+     * so editing operations only touch the tree and the package is serialized once when saved.
+     * Compressed nodes are expanded when loaded and compressed again at serialization, following the codec chosen for their type.
+     * Operations mirror the ones of Packer working on a raw buffer.
+     */
+    class Package
+    {
+        public :
+
+            struct NODE
+            {
+                /// Data type
+                Packer::DATA_TYPE type;
+
+                /// Node name
+                std::string name;
+
+                /// Object dependancies
+                std::vector<std::string> dependancies;
+
+                /// First byte of the node data, not used by containers
+                const char* data;
+
+                /// Data size, not used by containers
+                uint32_t size;
+
+                /// Decompressed or inserted data, owned by the node so that it is released with it
+                std::unique_ptr<std::vector<char>> buffer;
+
+                /// Container node
+                NODE* parent;
+
+                /// Children nodes, in serialization order
+                std::vector<std::unique_ptr<NODE>> children;
+
+                /// Children lookup table, key : name
+                std::map<std::string, NODE*> children_by_name;
+
+                /// Initialize to empty node
+                NODE() : type(Packer::DATA_TYPE::UNDEFINED), data(nullptr), size(0), parent(nullptr) {}
+
+                /**
+                 * Search for a direct child
+                 * @param child_name Child name
+                 * @return Pointer to the child if found, nullptr otherwise
+                 */
+                NODE* FindChild(std::string const& child_name) const;
+
+                /// Compute uncompressed serialized node size, header included
+                uint32_t SerializedSize() const;
+            };
+
+            /// Empty package
+            Package();
+
+            /// Nodes keep a pointer to their container, the package can't be copied or moved
+            Package(Package const&) = delete;
+            Package& operator=(Package const&) = delete;
+
+            /**
+             * Replace package content by a node tree
+             * @param memory Node tree, as produced by Serialize() or Packer::ExtractPackageBody()
+             * @retval false if a node could not be decompressed, the package is left empty
+             */
+            bool Load(std::vector<char> memory);
+
+            /// Remove all nodes
+            void Clear();
+
+            /**
+             * Serialize the node tree in a single pass
+             * @return Node tree, readable with Packer::UnpackMemory()
+             */
+            std::vector<char> Serialize() const;
+
+            /**
+             * Choose the codec used to serialize the nodes of a given type.
+             * Containers are never compressed, and a node is stored raw when compression doesn't reduce its size.
+             * @param type Data type
+             * @param codec Codec, Compression::NONE to store data as is
+             */
+            inline void SetCompression(Packer::DATA_TYPE type, Compression::CODEC codec) { this->compression[type] = codec; }
+
+            /// Get the root node
+            inline NODE const& GetRoot() const { return this->root; }
+
+            /**
+             * Search for a node at desired location
+             * @param path Search location
+             * @return Pointer to the node if found, nullptr otherwise
+             */
+            inline NODE const* Find(std::string const& path) const { return this->FindNode(path); }
+
+            /**
+             * Insert data inside the package
+             * @param path Destination node
+             * @param type Insertion type
+             * @param name Insertion name
+             * @param data Serialized data to insert, copied by the package
+             * @param data_size Serialized data size
+             * @param dependancies Object dependancies
+             * @retval true Success
+             * @retval false Data not inserted
+             */
+            bool PackToMemory(std::string const& path, Packer::DATA_TYPE const type,
+                              std::string const& name, std::unique_ptr<char> const& data, uint32_t data_size,
+                              std::vector<std::string> dependancies = {});
+
+            /**
+             * Change the name of the specified node
+             * @param path Specified node
+             * @param name New name
+             * @retval true Success
+             * @retval false Node not found or name already used in its container
+             */
+            bool SetNodeName(std::string const& path, std::string const& name);
+
+            /**
+             * Removes the specified node, root path clears the package
+             * @param path Target node path
+             */
+            void RemoveNode(std::string const& path);
+
+            /**
+             * Moves a node from a container to an other, with the same rules as Packer::MoveNode()
+             * @param source_path Node to move
+             * @param dest_path Destination container
+             * @retval true Data has changed
+             * @retval false Data not changed
+             */
+            bool MoveNode(std::string const& source_path, std::string const& dest_path);
+
+            /**
+             * Get the data type of specified node
+             * @param path Target node path
+             * @return Data type
+             */
+            Packer::DATA_TYPE GetNodeType(std::string const& path) const;
+
+            /**
+             * Change the type of the specified node
+             * @param path Specified node
+             * @param type New type
+             */
+            void SetNodeType(std::string const& path, Packer::DATA_TYPE type);
+
+            /**
+             * Change the value of the specified dependancy
+             * @param path Specified node
+             * @param index Dependancy index
+             * @param value Dependancy value
+             */
+            void SetNodeDependancy(std::string const& path, uint8_t index, std::string const& value);
+
+            /**
+             * Repair broken references to a modified path
+             * @param old_path Broken dependancy path
+             * @param new_path New dependancy path
+             */
+            void FixDependancies(std::string const& old_path, std::string const& new_path);
+
+        private :
+
+            /// Root node
+            NODE root;
+
+            /// Loaded node tree, referenced by the data of uncompressed nodes until the package is cleared
+            std::vector<std::unique_ptr<std::vector<char>>> buffers;
+
+            /// Codec used at serialization, by data type
+            std::map<Packer::DATA_TYPE, Compression::CODEC> compression;
+
+            /**
+             * Search for a node at desired location
+             * @param path Search location
+             * @return Pointer to the node if found, nullptr otherwise
+             */
+            NODE* FindNode(std::string const& path) const;
+
+            /**
+             * Build child nodes from a node tree buffer
+             * @param parent Container receiving the nodes
+             * @param memory Node tree
+             * @param size Node tree size
+             */
+            bool ParseNodes(NODE& parent, const char* memory, uint32_t size);
+
+            /**
+             * Append a child to a container
+             * @param parent Container
+             * @param child Node to append
+             * @return Pointer to the appended node
+             */
+            static NODE* AttachNode(NODE& parent, std::unique_ptr<NODE> child);
+
+            /**
+             * Remove a node from its container
+             * @param node Node to detach
+             * @return Node ownership
+             */
+            static std::unique_ptr<NODE> DetachNode(NODE& node);
+
+            /**
+             * Append a node and its children to the serialized tree
+             * @param node Node to write
+             * @param output Serialized tree
+             */
+            void WriteNode(NODE const& node, std::vector<char>& output) const;
+
+            /**
+             * Recursive part of FixDependancies()
+             * @param node Node to update with its children
+             * @param old_path Broken dependancy path
+             * @param new_path New dependancy path
+             */
+            static void FixDependancies(NODE& node, std::string const& old_path, std::string const& new_path);
+    };
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "PackageIndex.h"
+
+namespace DataPacker
+{
+    bool PackageIndex::Build(const char* memory, size_t size)
+    {
+        this->Clear();
+        if(memory == nullptr || !size) return true;
+
+        // Package file : the table of contents is already sorted
+        if(Packer::IsPackageFile(memory, size)) {
+            Packer::FILE_HEADER const* header = Packer::GetFileHeader(memory, size);
+            if(header == nullptr) return false;
+
+            const char* toc = memory + sizeof(Packer::FILE_HEADER);
+            this->entries.resize(header->entry_count);
+            if(header->entry_count > 0) std::memcpy(this->entries.data(), toc, header->entry_count * sizeof(ENTRY));
+
+            toc += header->entry_count * sizeof(ENTRY);
+            this->dependancies.resize(header->dependancy_count);
+            if(header->dependancy_count > 0) std::memcpy(this->dependancies.data(), toc, header->dependancy_count * sizeof(uint32_t));
+
+            if(!this->HasValidEntries(size) || this->HasCollision()) {
+                this->Clear();
+                return false;
+            }
+
+            return true;
+        }
+
+        // Legacy package : walk the node tree
+        std::vector<Packer::DATA> package = Packer::UnpackMemory(memory, size);
+        std::vector<std::vector<std::string>> dependancy_paths;
+        this->Insert(package, "/", dependancy_paths);
+
+        // Sort entries by hash
+        std::vector<uint32_t> order(this->entries.size());
+        for(uint32_t i=0; i<order.size(); i++) order[i] = i;
+        std::sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) { return this->entries[a].hash < this->entries[b].hash; });
+
+        std::vector<ENTRY> sorted_entries(this->entries.size());
+        for(uint32_t i=0; i<order.size(); i++) sorted_entries[i] = this->entries[order[i]];
+        this->entries = std::move(sorted_entries);
+
+        if(this->HasCollision()) {
+            this->Clear();
+            return false;
+        }
+
+        // Resolve dependancy paths to entry indices
+        for(uint32_t i=0; i<this->entries.size(); i++) {
+            ENTRY& entry = this->entries[i];
+            entry.first_dependancy = static_cast<uint32_t>(this->dependancies.size());
+            for(auto const& path : dependancy_paths[order[i]]) {
+                ENTRY const* dependancy = this->Find(path);
+                this->dependancies.push_back(dependancy == nullptr ? Packer::UNRESOLVED_DEPENDANCY : static_cast<uint32_t>(dependancy - this->entries.data()));
+            }
+        }
+
+        return true;
+    }
+
+    bool PackageIndex::HasCollision() const
+    {
+        for(uint32_t i=1; i<this->entries.size(); i++) {
+            if(this->entries[i].hash == this->entries[i-1].hash) {
+                #if defined(DISPLAY_LOGS)
+                std::cout << "PackageIndex::Build() : path hash collision, package rejected" << std::endl;
+                #endif
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool PackageIndex::HasValidEntries(size_t size) const
+    {
+        for(auto const& entry : this->entries) {
+            if(static_cast<uint64_t>(entry.offset) + entry.size > size
+               || static_cast<uint64_t>(entry.first_dependancy) + entry.dependancy_count > this->dependancies.size()) {
+                #if defined(DISPLAY_LOGS)
+                std::cout << "PackageIndex::Build() : entry out of bounds, package rejected" << std::endl;
+                #endif
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void PackageIndex::Insert(std::vector<Packer::DATA> const& package, std::string const& parent_path, std::vector<std::vector<std::string>>& dependancy_paths)
+    {
+        for(auto const& pack : package) {
+
+            std::string path = parent_path + pack.name;
+
+            ENTRY entry;
+            entry.hash = PackageIndex::HashPath(path);
+            entry.offset = pack.position + pack.HeaderSize();
+            entry.size = pack.size;
+            entry.first_dependancy = 0;
+            entry.dependancy_count = static_cast<uint8_t>(pack.dependancies.size());
+            entry.type = pack.type;
+            entry.flags = pack.compressed ? Packer::TOC_COMPRESSED : 0;
+            this->entries.push_back(entry);
+            dependancy_paths.push_back(pack.dependancies);
+
+            if(!pack.children.empty()) this->Insert(pack.children, path + "/", dependancy_paths);
+        }
+    }
+
+    PackageIndex::ENTRY const* PackageIndex::Find(uint64_t hash) const
+    {
+        auto item = std::lower_bound(this->entries.begin(), this->entries.end(), hash, [](ENTRY const& entry, uint64_t value) { return entry.hash < value; });
+        if(item == this->entries.end() || item->hash != hash) return nullptr;
+        return &(*item);
+    }
+
+    PackageIndex::ENTRY const* PackageIndex::GetDependancy(ENTRY const& entry, uint8_t index) const
+    {
+        if(index >= entry.dependancy_count) return nullptr;
+        uint32_t dependancy = this->dependancies[entry.first_dependancy + index];
+        if(dependancy >= this->entries.size()) return nullptr;
+        return &this->entries[dependancy];
+    }
+
+    uint64_t PackageIndex::HashPath(std::string const& path)
+    {
+        std::string normalized = PackageIndex::NormalizePath(path);
+
+        uint64_t hash = 14695981039346656037ull;
+        for(char c : normalized) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    std::string PackageIndex::NormalizePath(std::string const& path)
+    {
+        std::string normalized = path;
+        if(normalized.empty() || normalized[0] != '/') normalized = '/' + normalized;
+        while(normalized.size() > 1 && normalized[normalized.size() - 1] == '/') normalized.pop_back();
+        return normalized;
+    }
+}
\ No newline at end of file
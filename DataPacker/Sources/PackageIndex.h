@@ -0,0 +1,114 @@
+#pragma once
+
+#include "DataPacker.h"
+
+namespace DataPacker
+{
+    /**
+     * Flat lookup table of a packaged buffer, built once and shared by every loader call.
+     * Nodes are stored as table of contents entries sorted by the hash of their full path ("/folder/node"),
+     * so finding an item is a binary search instead of a recursive scan of the whole tree.
+     * Package files embedding a table of contents are indexed without parsing the node tree.
+     */
+    class PackageIndex
+    {
+        public :
+
+            /// Indexed node
+            using ENTRY = Packer::TOC_ENTRY;
+
+            /// Empty index
+            PackageIndex() = default;
+
+            /// Build index from packaged buffer
+            PackageIndex(std::vector<char> const& memory) { this->Build(memory); }
+
+            /**
+             * Parse a packaged buffer and fill the index, previous content is cleared
+             * @param memory Packaged buffer
+             * @retval false if the package is corrupted or two paths share the same hash, the index is left empty
+             */
+            inline bool Build(std::vector<char> const& memory) { return this->Build(memory.data(), memory.size()); }
+
+            /**
+             * Parse a packaged memory area and fill the index, previous content is cleared.
+             * Entries only keep the hash of their path, a package with two paths sharing a hash is rejected
+             * so that Find() can't return the wrong node. Package files are rejected if their header or any entry
+             * points outside of the file, so that entries can be read without further checks.
+             * @param memory First byte of the package
+             * @param size Package size
+             * @retval false if the package is corrupted or two paths share the same hash, the index is left empty
+             */
+            bool Build(const char* memory, size_t size);
+
+            /**
+             * Search for an item by its full path
+             * @param path Item location, with or without leading slash
+             * @return Pointer to the entry if found, nullptr otherwise
+             */
+            inline ENTRY const* Find(std::string const& path) const { return this->Find(PackageIndex::HashPath(path)); }
+
+            /**
+             * Search for an item by its path hash
+             * @param hash Hash of the item full path, obtained with HashPath()
+             * @return Pointer to the entry if found, nullptr otherwise
+             */
+            ENTRY const* Find(uint64_t hash) const;
+
+            /**
+             * Get a dependancy of an indexed item
+             * @param entry Indexed item
+             * @param index Dependancy index, lower than entry.dependancy_count
+             * @return Pointer to the dependancy entry, nullptr if the dependancy is not part of the package
+             */
+            ENTRY const* GetDependancy(ENTRY const& entry, uint8_t index) const;
+
+            /// Indexed nodes, sorted by path hash
+            inline std::vector<ENTRY> const& GetEntries() const { return this->entries; }
+
+            /// Dependancy indices of every node, see ENTRY::first_dependancy
+            inline std::vector<uint32_t> const& GetDependancies() const { return this->dependancies; }
+
+            /// Number of indexed nodes
+            inline size_t Count() const { return this->entries.size(); }
+
+            /// Clear index
+            inline void Clear() { this->entries.clear(); this->dependancies.clear(); }
+
+            /**
+             * Compute the 64 bits FNV-1a hash of a node path
+             * @param path Node location, with or without leading slash
+             * @return Path hash
+             */
+            static uint64_t HashPath(std::string const& path);
+
+        private :
+
+            /// Indexed nodes, sorted by path hash
+            std::vector<ENTRY> entries;
+
+            /// Dependancy indices in entries array
+            std::vector<uint32_t> dependancies;
+
+            /// Check that every path hash is unique, entries must be sorted
+            bool HasCollision() const;
+
+            /// Check that the data and dependancies of every entry lie inside the package
+            bool HasValidEntries(size_t size) const;
+
+            /**
+             * Recursively insert unpacked nodes
+             * @param package Data table obtained with Packer::UnpackMemory()
+             * @param parent_path Path of the container, finished by a slash
+             * @param dependancy_paths Dependancies of inserted nodes, filled in the same order as entries
+             */
+            void Insert(std::vector<Packer::DATA> const& package, std::string const& parent_path, std::vector<std::vector<std::string>>& dependancy_paths);
+
+            /**
+             * Make path always start by a slash and never finish by one
+             * @param path Given path
+             * @return Normalized path
+             */
+            static std::string NormalizePath(std::string const& path);
+    };
+}
\ No newline at end of file
@@ -52,6 +52,8 @@
 #define ID_SETTYPE_MESH                 40028
 #define ID_SETTYPE_MATERIAL             40029
 #define ID_SETTYPE_BONETREE             40030
+#define ID_COOK_MESHES                  40031
+#define ID_COOK_MESHES_COMPACT          40032
 
 // Next default values for new objects
 // 
@@ -59,7 +61,7 @@
 #ifndef APSTUDIO_READONLY_SYMBOLS
 #define _APS_NO_MFC                     1
 #define _APS_NEXT_RESOURCE_VALUE        118
-#define _APS_NEXT_COMMAND_VALUE         40031
+#define _APS_NEXT_COMMAND_VALUE         40033
 #define _APS_NEXT_CONTROL_VALUE         1011
 #define _APS_NEXT_SYMED_VALUE           101
 #endif
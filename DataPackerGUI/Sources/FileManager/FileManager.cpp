@@ -12,6 +12,10 @@ namespace DataPackerGUI
             FileManager::instance->tree_view = tree_view;
             FileManager::instance->list_view_main = list_view_main;
             FileManager::instance->list_view_inspect = list_view_inspect;
+
+            // Images are already compressed by their own format
+            FileManager::instance->package.SetCompression(DataPacker::Packer::MESH_DATA, DataPacker::Compression::LZ4);
+            FileManager::instance->package.SetCompression(DataPacker::Packer::BONE_TREE, DataPacker::Compression::LZ4);
             tree_view->AddListener(FileManager::instance);
             list_view_main->AddListener(FileManager::instance);
         }
@@ -80,7 +84,13 @@ namespace DataPackerGUI
         this->UpdateTitle();
 
         // Load data and fill TreeView
-        this->data = Tools::GetBinaryFileContents(this->file_path);
+        if(!this->package.Load(Tools::GetBinaryFileContents(this->file_path))) {
+            MessageBox(nullptr, L"Unable to read package, some data is corrupted.", L"KazEngine DataPacker", MB_ICONERROR);
+            this->file_path.clear();
+            this->UpdateTitle();
+            this->RefreshTreeView();
+            return;
+        }
         this->RefreshTreeView();
 
         // Enable TreeView
@@ -102,18 +112,18 @@ namespace DataPackerGUI
         }
     }
 
-    void FileManager::BuildTreeFromPackage(HTREEITEM parent, std::vector<DataPacker::Packer::DATA> const& package)
+    void FileManager::BuildTreeFromPackage(HTREEITEM parent, DataPacker::Package::NODE const& node)
     {
-        for(auto const& pack : package) {
+        for(auto const& child : node.children) {
             int image = -1;
-            if(pack.type == DataPacker::Packer::PARENT_NODE) image = 1;
-            else if(pack.type == DataPacker::Packer::MESH_DATA) image = 2;
-            else if(pack.type == DataPacker::Packer::MATERIAL_DATA) image = 3;
-            else if(pack.type == DataPacker::Packer::IMAGE_FILE) image = 4;
-            else if(pack.type == DataPacker::Packer::BONE_TREE) image = 5;
-
-            HTREEITEM item = this->tree_view->InsertItem(pack.name, parent, TVI_LAST, image, image);
-            this->BuildTreeFromPackage(item, pack.children);
+            if(child->type == DataPacker::Packer::PARENT_NODE) image = 1;
+            else if(child->type == DataPacker::Packer::MESH_DATA || child->type == DataPacker::Packer::MESH_VBO) image = 2;
+            else if(child->type == DataPacker::Packer::MATERIAL_DATA) image = 3;
+            else if(child->type == DataPacker::Packer::IMAGE_FILE) image = 4;
+            else if(child->type == DataPacker::Packer::BONE_TREE) image = 5;
+
+            HTREEITEM item = this->tree_view->InsertItem(child->name, parent, TVI_LAST, image, image);
+            this->BuildTreeFromPackage(item, *child);
         }
     }
 
@@ -126,7 +136,7 @@ namespace DataPackerGUI
         }
 
         this->file_path.clear();
-        this->data.clear();
+        this->package.Clear();
         this->tree_view->Clear();
         this->UpdateTitle();
     }
@@ -140,7 +150,7 @@ namespace DataPackerGUI
         }
 
         if(user_reply == IDCANCEL) return false;
-        this->data.clear();
+        this->package.Clear();
         this->tree_view->Clear();
         return true;
     }
@@ -173,8 +183,15 @@ namespace DataPackerGUI
             if(this->file_path.empty()) return false;
         }
 
+        // Two node paths sharing the same hash can't be indexed
+        std::vector<char> file = DataPacker::Packer::BuildPackageFile(this->package.Serialize());
+        if(file.empty()) {
+            MessageBox(nullptr, L"Unable to index package, rename one of the nodes.", L"KazEngine DataPacker", MB_ICONERROR);
+            return false;
+        }
+
         // Error during data writing
-        if(!Tools::WriteToFile(this->data, this->file_path)) {
+        if(!Tools::WriteToFile(file, this->file_path)) {
             MessageBox(nullptr, L"Unable to save file.", L"KazEngine DataPacker", MB_ICONERROR);
             return false;
         }
@@ -193,7 +210,7 @@ namespace DataPackerGUI
         if(path.empty()) return;
 
         // Get context menu target type
-        DataPacker::Packer::DATA_TYPE item_type = DataPacker::Packer::GetNodeType(this->data, path);
+        DataPacker::Packer::DATA_TYPE item_type = this->package.GetNodeType(path);
         uint32_t menu_id;
         if(item_type == DataPacker::Packer::DATA_TYPE::ROOT_NODE) menu_id = IDR_TREE_CONTEXT_ROOT;
         else if(item_type == DataPacker::Packer::DATA_TYPE::PARENT_NODE) menu_id = IDR_TREE_CONTEXT_FOLDER;
@@ -232,11 +249,10 @@ namespace DataPackerGUI
 
         // Change item label and node name
         this->tree_view->SetItemName(item, label);
-        DataPacker::Packer::SetNodeName(this->data, path, label);
+        this->package.SetNodeName(path, label);
 
         // Any reference to this item and its children must be fixed
-        auto package = DataPacker::Packer::UnpackMemory(this->data);
-        DataPacker::Packer::FixDependancies(this->data, path, new_path, package);
+        this->package.FixDependancies(path, new_path);
 
         this->need_save = true;
         this->UpdateTitle();
@@ -244,13 +260,12 @@ namespace DataPackerGUI
 
     void FileManager::OnDropItem(std::string const& source_path, std::string const& dest_path)
     {
-        bool moved = DataPacker::Packer::MoveNode(this->data, source_path, dest_path);
+        bool moved = this->package.MoveNode(source_path, dest_path);
         if(moved) {
             
             // Any reference to this item and its children must be fixed
-            auto package = DataPacker::Packer::UnpackMemory(this->data);
             std::string moved_path = Tools::FinishBySlash(dest_path) + Tools::GetFileName(source_path);
-            DataPacker::Packer::FixDependancies(this->data, source_path, moved_path, package);
+            this->package.FixDependancies(source_path, moved_path);
 
             this->RefreshTreeView();
             this->need_save = true;
@@ -261,21 +276,14 @@ namespace DataPackerGUI
     void FileManager::RefreshTreeView()
     {
         this->tree_view->Clear();
-        std::vector<DataPacker::Packer::DATA> package = DataPacker::Packer::UnpackMemory(this->data);
         HTREEITEM root = this->tree_view->InsertItem("root");
-        this->BuildTreeFromPackage(root, package);
+        this->BuildTreeFromPackage(root, this->package.GetRoot());
     }
 
     void FileManager::OnDropFiles(std::vector<std::wstring> const& files_path, std::string const& dest_path)
     {
-        // Unpack data
-        std::vector<DataPacker::Packer::DATA> data_table = DataPacker::Packer::UnpackMemory(this->data);
-
-        // Find destination node
-        DataPacker::Packer::DATA data = DataPacker::Packer::FindPackedItem(data_table, dest_path);
-
         // Destination node must be a container
-        if(!DataPacker::Packer::IsContainer(data.type)) return;
+        if(!DataPacker::Packer::IsContainer(this->package.GetNodeType(dest_path))) return;
 
         for(auto const& path : files_path) {
 
@@ -309,7 +317,7 @@ namespace DataPackerGUI
 
                     // Pack data to destination path
                     std::unique_ptr<char> package_ptr(package.data());
-                    bool packed = DataPacker::Packer::PackToMemory(this->data, dest_path, DataPacker::Packer::DATA_TYPE::MODEL_TREE, filename, package_ptr, static_cast<uint32_t>(package.size()));
+                    bool packed = this->package.PackToMemory(dest_path, DataPacker::Packer::DATA_TYPE::MODEL_TREE, filename, package_ptr, static_cast<uint32_t>(package.size()));
                     package_ptr.release();
                     this->need_save = packed;
 
@@ -321,6 +329,7 @@ namespace DataPackerGUI
 
                     // Get file content
                     std::vector<char> kea_data = Tools::GetBinaryFileContents(path);
+                    if(extension == L"kea") kea_data = DataPacker::Packer::ExtractPackageBody(kea_data);
 
                     DataPacker::Packer::DATA_TYPE data_type;
                     if(extension == L"kea") data_type = DataPacker::Packer::DATA_TYPE::MODEL_TREE;
@@ -329,7 +338,7 @@ namespace DataPackerGUI
 
                     // Copy data to destination path
                     std::unique_ptr<char> package_ptr(kea_data.data());
-                    DataPacker::Packer::PackToMemory(this->data, dest_path, data_type, filename, package_ptr, static_cast<uint32_t>(kea_data.size()));
+                    this->package.PackToMemory(dest_path, data_type, filename, package_ptr, static_cast<uint32_t>(kea_data.size()));
                     package_ptr.release();
                     this->need_save = true;
                     
@@ -359,7 +368,7 @@ namespace DataPackerGUI
             i++;
         }
 
-        DataPacker::Packer::PackToMemory(this->data, path, DataPacker::Packer::PARENT_NODE, folder_name, {}, 0);
+        this->package.PackToMemory(path, DataPacker::Packer::PARENT_NODE, folder_name, {}, 0);
         HTREEITEM parent = this->tree_view->FindItem(path);
         HTREEITEM folder = this->tree_view->InsertItem(folder_name, parent, TVI_SORT, 1, 1);
         this->tree_view->Expand(parent);
@@ -367,22 +376,77 @@ namespace DataPackerGUI
         this->UpdateTitle();
     }
 
+    void FileManager::CookMeshes(std::string const& path, Model::CookedMesh::VERTEX_FORMAT format)
+    {
+        auto folder = this->package.Find(path);
+        if(folder == nullptr) return;
+
+        // Children are sorted by name, LOD0 comes first
+        std::vector<std::shared_ptr<Model::Mesh>> lods;
+        std::vector<std::string> lod_names;
+        std::vector<std::string> dependancies;
+        for(auto const& child : folder->children_by_name) {
+            if(child.second->type != DataPacker::Packer::MESH_DATA || child.second->data == nullptr) continue;
+
+            std::shared_ptr<Model::Mesh> mesh(new Model::Mesh);
+            mesh->Deserialize(child.second->data);
+            lods.push_back(mesh);
+            lod_names.push_back(child.first);
+
+            for(auto const& dependancy : child.second->dependancies)
+                if(std::find(dependancies.begin(), dependancies.end(), dependancy) == dependancies.end()) dependancies.push_back(dependancy);
+        }
+
+        if(lods.empty()) {
+            MessageBox(this->hwnd, L"No mesh in this folder", L"Error", MB_ICONERROR);
+            return;
+        }
+
+        uint32_t cooked_size;
+        std::vector<Model::CookedMesh::LOD_REPORT> report;
+        std::unique_ptr<char> cooked = Model::CookedMesh::Cook(lods, cooked_size, format, &report);
+
+        // Vertex cache report, ACMR is given for a 16 entries FIFO
+        Log::Terminal::Open();
+        Model::CookedMesh cooked_mesh;
+        if(format == Model::CookedMesh::COMPACT_VERTEX && cooked_mesh.Deserialize(cooked.get(), cooked_size)
+           && cooked_mesh.GetVertexFormat() != Model::CookedMesh::COMPACT_VERTEX)
+            std::cout << "Bone ids don't fit in compact vertices, float vertices are used" << std::endl;
+        for(uint8_t i=0; i<report.size(); i++) {
+            std::cout << "Cooking [" << lod_names[i] << "] : ACMR " << report[i].before.acmr << " => " << report[i].after.acmr
+                      << ", ATVR " << report[i].before.atvr << " => " << report[i].after.atvr << std::endl;
+        }
+        Log::Terminal::Pause();
+        Log::Terminal::Close();
+
+        // Replace previous cooking
+        std::string const cooked_name = "cooked";
+        if(folder->FindChild(cooked_name) != nullptr) this->DeleteObject(path + "/" + cooked_name);
+
+        if(!this->package.PackToMemory(path, DataPacker::Packer::MESH_VBO, cooked_name, cooked, cooked_size, dependancies)) return;
+        HTREEITEM parent = this->tree_view->FindItem(path);
+        this->tree_view->InsertItem(cooked_name, parent, TVI_SORT, 2, 2);
+        this->tree_view->Expand(parent);
+        this->need_save = true;
+        this->UpdateTitle();
+    }
+
     void FileManager::DeleteObject(std::string const& path)
     {
         HTREEITEM item = this->tree_view->FindItem(path);
         this->tree_view->DeleteItem(item);
-        DataPacker::Packer::RemoveNode(this->data, path);
+        this->package.RemoveNode(path);
         this->need_save = true;
         this->UpdateTitle();
     }
 
     void FileManager::SetNodeType(std::string const& path, DataPacker::Packer::DATA_TYPE type)
     {
-        DataPacker::Packer::SetNodeType(this->data, path, type);
+        this->package.SetNodeType(path, type);
 
         int image = -1;
         if(type == DataPacker::Packer::PARENT_NODE) image = 1;
-        else if(type == DataPacker::Packer::MESH_DATA) image = 2;
+        else if(type == DataPacker::Packer::MESH_DATA || type == DataPacker::Packer::MESH_VBO) image = 2;
         else if(type == DataPacker::Packer::MATERIAL_DATA) image = 3;
         else if(type == DataPacker::Packer::IMAGE_FILE) image = 4;
         else if(type == DataPacker::Packer::BONE_TREE) image = 5;
@@ -393,7 +457,7 @@ namespace DataPackerGUI
 
     void FileManager::OnTvItemSelect(std::string const& path)
     {
-        DataPacker::Packer::DATA_TYPE type = DataPacker::Packer::GetNodeType(this->data, path);
+        DataPacker::Packer::DATA_TYPE type = this->package.GetNodeType(path);
         this->list_view_main->Clear();
         this->list_view_inspect->Hide();
 
@@ -401,10 +465,9 @@ namespace DataPackerGUI
         {
             case DataPacker::Packer::MESH_DATA :
             {   
-                auto data_tree = DataPacker::Packer::UnpackMemory(this->data);
-                auto node = DataPacker::Packer::FindPackedItem(data_tree, path);
+                auto node = this->package.Find(path);
                 std::shared_ptr<Model::Mesh> mesh(new Model::Mesh);
-                mesh->Deserialize(node.Data(this->data.data()));
+                mesh->Deserialize(node->data);
                 this->list_view_main->Display(mesh);
                 EnableWindow(this->list_view_main->GetHwnd(), TRUE);
                 return;
@@ -423,33 +486,29 @@ namespace DataPackerGUI
         std::string field_name = list_view.GetSubItemText(item_index, 0);
 
         if(field_name == "Vertices") {
-            auto data_tree = DataPacker::Packer::UnpackMemory(this->data);
-            auto node = DataPacker::Packer::FindPackedItem(data_tree, path);
+            auto node = this->package.Find(path);
             std::shared_ptr<Model::Mesh> mesh(new Model::Mesh);
-            mesh->Deserialize(node.Data(this->data.data()));
+            mesh->Deserialize(node->data);
             this->list_view_inspect->Display(mesh->vertex_buffer);
             this->list_view_inspect->Show();
 
         } else if(field_name == "Indices") {
-            auto data_tree = DataPacker::Packer::UnpackMemory(this->data);
-            auto node = DataPacker::Packer::FindPackedItem(data_tree, path);
+            auto node = this->package.Find(path);
             std::shared_ptr<Model::Mesh> mesh(new Model::Mesh);
-            mesh->Deserialize(node.Data(this->data.data()));
+            mesh->Deserialize(node->data);
             this->list_view_inspect->Display(mesh->index_buffer);
             this->list_view_inspect->Show();
 
         } else if(field_name == "UV") {
-            auto data_tree = DataPacker::Packer::UnpackMemory(this->data);
-            auto node = DataPacker::Packer::FindPackedItem(data_tree, path);
+            auto node = this->package.Find(path);
             std::shared_ptr<Model::Mesh> mesh(new Model::Mesh);
-            mesh->Deserialize(node.Data(this->data.data()));
+            mesh->Deserialize(node->data);
             this->list_view_inspect->Display(mesh->uv_buffer);
             this->list_view_inspect->Show();
 
         } else if(field_name == "Dependances") {
-            auto data_tree = DataPacker::Packer::UnpackMemory(this->data);
-            auto node = DataPacker::Packer::FindPackedItem(data_tree, path);
-            this->list_view_inspect->Display(node.dependancies);
+            auto node = this->package.Find(path);
+            this->list_view_inspect->Display(node->dependancies);
             this->list_view_inspect->Show();
 
         //} else if(field_name == "Material") {
@@ -8,6 +8,7 @@
 #include <Types.hpp>
 #include "../../Resources/resource.h"
 #include "../../DataPacker/Sources/DataPacker.h"
+#include "../../DataPacker/Sources/Package.h"
 #include "../TreeView/TreeView.h"
 #include "../Import/Import.h"
 #include "../ListView/ListView.h"
@@ -72,6 +73,14 @@ namespace DataPackerGUI
              */
             void DeleteObject(std::string const& path);
 
+            /**
+             * Build a GPU ready vertex buffer from the meshes of a folder.
+             * Meshes are taken in name order as LOD levels, the result replaces any previous "cooked" node of the folder
+             * @param path Folder location
+             * @param format Vertex layout, compact vertices are quantized to 20 bytes
+             */
+            void CookMeshes(std::string const& path, Model::CookedMesh::VERTEX_FORMAT format);
+
             /// Complete rebuild of TreeView from raw data
             void RefreshTreeView();
 
@@ -103,8 +112,8 @@ namespace DataPackerGUI
             /// Singleton instance
             static FileManager* instance;
 
-            /// Raw data
-            std::vector<char> data;
+            /// Editable package content
+            DataPacker::Package package;
 
             /// File path
             std::string file_path;
@@ -128,7 +137,7 @@ namespace DataPackerGUI
             void UpdateTitle();
 
             /// Fill the TreeView with parsed data
-            void BuildTreeFromPackage(HTREEITEM parent, std::vector<DataPacker::Packer::DATA> const& package);
+            void BuildTreeFromPackage(HTREEITEM parent, DataPacker::Package::NODE const& node);
 
             /// Singleton constructor
             FileManager() = default;
@@ -57,8 +57,12 @@ namespace DataPackerGUI
             this->RebuildBoneTree(tree.second, skeep);
         this->ComputeAnimations();
 
+        // Suppression des KeyFrames redondantes
+        for(auto& tree : this->bone_trees)
+            tree.second.ReduceKeyFrames();
+
         // Cration des conteneurs pour textures et meshes
-        std::vector<char> memory;
+        DataPacker::Package package;
         std::vector<std::string> added_textures;
         std::vector<std::string> added_materials;
         // DataPacker::Packer::PackToMemory(memory, "/", DataPacker::Packer::DATA_TYPE::PARENT_NODE, "textures", {}, 0);
@@ -73,7 +77,7 @@ namespace DataPackerGUI
             std::vector<char> serialized = tree.second.Serialize();
             std::unique_ptr<char> serialized_tree(serialized.data());
             std::cout << "Empaquetage du squelette [" << tree.first << "] : ";
-            DataPacker::Packer::PackToMemory(memory, "/", DataPacker::Packer::DATA_TYPE::BONE_TREE, tree.first, serialized_tree, static_cast<uint32_t>(serialized.size()));
+            package.PackToMemory("/", DataPacker::Packer::DATA_TYPE::BONE_TREE, tree.first, serialized_tree, static_cast<uint32_t>(serialized.size()));
             serialized_tree.release();
 
             Log::Terminal::SetTextColor(Log::Terminal::TEXT_COLOR::GREEN);
@@ -101,8 +105,8 @@ namespace DataPackerGUI
                     // Empaquetage de la texture
                     dependancies.push_back(package_directory + "/" + texture_name);
                     std::unique_ptr<char> file_content_ptr(file_content.data());
-                    DataPacker::Packer::PackToMemory(memory, "/", DataPacker::Packer::DATA_TYPE::IMAGE_FILE, texture_name,
-                                                        file_content_ptr, static_cast<uint32_t>(file_content.size()));
+                    package.PackToMemory("/", DataPacker::Packer::DATA_TYPE::IMAGE_FILE, texture_name,
+                                         file_content_ptr, static_cast<uint32_t>(file_content.size()));
                     file_content_ptr.release();
                         
                     Log::Terminal::SetTextColor(Log::Terminal::TEXT_COLOR::GREEN);
@@ -179,7 +183,7 @@ namespace DataPackerGUI
             uint32_t serialized_mesh_size;
             std::unique_ptr<char> serialized_mesh = mesh.Serialize(serialized_mesh_size);
             std::cout << "Empaquetage de mesh [" << mesh.name << "] : ";
-            DataPacker::Packer::PackToMemory(memory, "/", DataPacker::Packer::DATA_TYPE::MESH_DATA, mesh.name, serialized_mesh, serialized_mesh_size, dependancies);
+            package.PackToMemory("/", DataPacker::Packer::DATA_TYPE::MESH_DATA, mesh.name, serialized_mesh, serialized_mesh_size, dependancies);
 
             Log::Terminal::SetTextColor(Log::Terminal::TEXT_COLOR::GREEN);
             std::cout << "OK" << std::endl;
@@ -191,7 +195,7 @@ namespace DataPackerGUI
         std::cout << "Succs" << std::endl;
         Log::Terminal::SetTextColor();
 
-        return memory;
+        return package.Serialize();
     }
 
     FbxParser::FBX_NODE FbxParser::GetRootModel(FBX_NODE const& node, std::vector<FBX_NODE> const& models)
@@ -746,6 +750,9 @@ namespace DataPackerGUI
                         }
                     }
                 }
+
+                // Tri des influences et suppression des plus faibles
+                for(auto& deformer : serialized_mesh.deformers) deformer.Prune();
             }else if(mesh_geometry.cluster.id >= 0) {
                 uint32_t bone_id = UINT32_MAX;
                 if(this->referenced_bones.count(mesh_geometry.cluster.bone_id)) bone_id = this->referenced_bones[mesh_geometry.cluster.bone_id];
@@ -18,6 +18,7 @@
 #include "../Parser/Parser.h"
 #include "../../EngineModel/Sources/Model.h"
 #include "../../DataPacker/Sources/DataPacker.h"
+#include "../../DataPacker/Sources/Package.h"
 #include "../../Maths/Sources/Maths.h"
 #include "../../Tools/Sources/Tools.h"
 #include "../../LogManager/Sources/LogManager.h"
@@ -143,7 +143,7 @@ namespace DataPackerGUI
 
             for(uint8_t j=0; j<2; j++) {
                 std::memset(pszText, 0, item_text.size() * sizeof(wchar_t));
-                item_text = converter.from_bytes(std::to_string(buffer[i].value[j]));
+                item_text = converter.from_bytes(std::to_string(buffer[i][j]));
                 std::memcpy(pszText, item_text.data(), item_text.size() * sizeof(wchar_t));
                 item.iSubItem = j+1;
                 ListView_SetItem(this->hwnd, &item);
@@ -177,7 +177,7 @@ namespace DataPackerGUI
 
             for(uint8_t j=0; j<3; j++) {
                 std::memset(pszText, 0, item_text.size() * sizeof(wchar_t));
-                item_text = converter.from_bytes(std::to_string(buffer[i].value[j]));
+                item_text = converter.from_bytes(std::to_string(buffer[i][j]));
                 std::memcpy(pszText, item_text.data(), item_text.size() * sizeof(wchar_t));
                 item.iSubItem = j+1;
                 ListView_SetItem(this->hwnd, &item);
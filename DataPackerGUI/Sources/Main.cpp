@@ -212,6 +212,15 @@ LRESULT WINAPI WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                     return TRUE;
                 }
 
+                case ID_COOK_MESHES :
+                case ID_COOK_MESHES_COMPACT :
+                {
+                    DataPackerGUI::TreeView& treeview = DataPackerGUI::FileManager::GetInstance().GetLinkedTreeView();
+                    std::string path = treeview.GetPath(treeview.GetSelectedItem());
+                    DataPackerGUI::FileManager::GetInstance().CookMeshes(path, LOWORD(wParam) == ID_COOK_MESHES_COMPACT ? Model::CookedMesh::COMPACT_VERTEX : Model::CookedMesh::FLOAT_VERTEX);
+                    return TRUE;
+                }
+
                 case ID_SETTYPE_IMAGE :
                 {
                     DataPackerGUI::TreeView& treeview = DataPackerGUI::FileManager::GetInstance().GetLinkedTreeView();
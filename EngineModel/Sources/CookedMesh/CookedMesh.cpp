@@ -0,0 +1,320 @@
+#include "CookedMesh.h"
+
+#include <cfloat>
+#include <algorithm>
+
+namespace Model
+{
+    size_t CookedMesh::VERTEX_HASH::operator()(VERTEX const& vertex) const
+    {
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for(char byte : vertex) {
+            hash ^= static_cast<uint8_t>(byte);
+            hash *= 0x100000001b3ULL;
+        }
+        return static_cast<size_t>(hash);
+    }
+
+    CookedMesh::COOKED_LOD CookedMesh::CookLOD(Mesh const& mesh, bool optimize)
+    {
+        // Every index is a triangle corner, meshes without index buffer have one corner per vertex
+        uint32_t corner_count = static_cast<uint32_t>(mesh.index_buffer.empty() ? mesh.vertex_buffer.size() : mesh.index_buffer.size());
+        bool indexed = !mesh.index_buffer.empty();
+        bool has_deformers = mesh.deformers.size() > 1;
+        Maths::Vector2 empty_uv = {};
+        Deformer empty_deformer;
+
+        COOKED_LOD lod;
+        lod.report = {};
+        lod.max_influences = 0;
+        lod.indices.reserve(corner_count);
+        std::unordered_map<VERTEX, uint32_t, VERTEX_HASH> unique_vertices;
+        unique_vertices.reserve(corner_count);
+
+        for(uint32_t i=0; i<corner_count; i++) {
+
+            uint32_t vertex_index = indexed ? mesh.index_buffer[i] : i;
+            VERTEX vertex;
+            char* output = vertex.data();
+
+            // Position
+            std::memcpy(output, &mesh.vertex_buffer[vertex_index], sizeof(Maths::Vector3));
+            output += sizeof(Maths::Vector3);
+
+            // UV
+            Maths::Vector2 const* uv = &empty_uv;
+            if(!mesh.uv_index.empty()) uv = &mesh.uv_buffer[mesh.uv_index[i]];
+            else if(vertex_index < mesh.uv_buffer.size()) uv = &mesh.uv_buffer[vertex_index];
+            std::memcpy(output, uv, sizeof(Maths::Vector2));
+            output += sizeof(Maths::Vector2);
+
+            // Deformer, always present so that every vertex matches the pipeline stride
+            Deformer deformer = has_deformers ? mesh.deformers[vertex_index] : empty_deformer;
+            deformer.Prune(0.0f);
+            lod.max_influences = std::max(lod.max_influences, deformer.Size());
+            std::memcpy(output, deformer.bone_weights.data(), sizeof(deformer.bone_weights));
+            output += sizeof(deformer.bone_weights);
+            std::memcpy(output, deformer.bone_ids.data(), sizeof(deformer.bone_ids));
+
+            // Identical (position, uv, deformer) tuples share the same vertex
+            auto inserted = unique_vertices.emplace(vertex, static_cast<uint32_t>(lod.vertices.size()));
+            if(inserted.second) lod.vertices.push_back(vertex);
+            lod.indices.push_back(inserted.first->second);
+        }
+
+        if(!optimize) return lod;
+
+        // Triangle order for the post-transform cache, then vertex order for fetch locality
+        uint32_t vertex_count = static_cast<uint32_t>(lod.vertices.size());
+        lod.report.before = VertexCache::Analyze(lod.indices, vertex_count);
+        VertexCache::OptimizeTriangles(lod.indices, vertex_count);
+        std::vector<uint32_t> fetch_order = VertexCache::OptimizeFetch(lod.indices, vertex_count);
+        lod.report.after = VertexCache::Analyze(lod.indices, vertex_count);
+
+        std::vector<VERTEX> vertices(vertex_count);
+        for(uint32_t i=0; i<vertex_count; i++) vertices[i] = lod.vertices[fetch_order[i]];
+        lod.vertices = std::move(vertices);
+
+        return lod;
+    }
+
+    CookedMesh::DEQUANTIZATION CookedMesh::ComputeDequantization(std::vector<COOKED_LOD> const& lods)
+    {
+        std::array<float, 5> min_value, max_value;
+        min_value.fill(FLT_MAX);
+        max_value.fill(-FLT_MAX);
+
+        // Position and UV are the 5 first floats of a vertex
+        for(auto const& lod : lods) {
+            for(auto const& vertex : lod.vertices) {
+                std::array<float, 5> value;
+                std::memcpy(value.data(), vertex.data(), sizeof(value));
+                for(uint8_t i=0; i<value.size(); i++) {
+                    min_value[i] = std::min(min_value[i], value[i]);
+                    max_value[i] = std::max(max_value[i], value[i]);
+                }
+            }
+        }
+
+        DEQUANTIZATION dequantization;
+        for(uint8_t i=0; i<3; i++) {
+            dequantization.position_offset[i] = min_value[i];
+            dequantization.position_scale[i] = max_value[i] - min_value[i];
+        }
+        dequantization.position_scale.w = 1.0f;
+        dequantization.uv_transform = {min_value[3], min_value[4], max_value[3] - min_value[3], max_value[4] - min_value[4]};
+
+        return dequantization;
+    }
+
+    void CookedMesh::WriteCompactVertex(VERTEX const& vertex, DEQUANTIZATION const& dequantization, char* output)
+    {
+        std::array<float, 5> position_uv;
+        std::memcpy(position_uv.data(), vertex.data(), sizeof(position_uv));
+        Deformer deformer;
+        std::memcpy(deformer.bone_weights.data(), vertex.data() + sizeof(position_uv), sizeof(deformer.bone_weights));
+        std::memcpy(deformer.bone_ids.data(), vertex.data() + sizeof(position_uv) + sizeof(deformer.bone_weights), sizeof(deformer.bone_ids));
+
+        // Values are stored relative to their bounding box, on the full unorm16 range
+        auto quantize16 = [](float value, float offset, float scale) -> uint16_t {
+            if(scale <= 0.0f) return 0;
+            float normalized = std::min(std::max((value - offset) / scale, 0.0f), 1.0f);
+            return static_cast<uint16_t>(normalized * UINT16_MAX + 0.5f);
+        };
+
+        std::array<uint16_t, 6> position_uv16 = {};
+        for(uint8_t i=0; i<3; i++) position_uv16[i] = quantize16(position_uv[i], dequantization.position_offset[i], dequantization.position_scale[i]);
+        position_uv16[3] = UINT16_MAX;
+        position_uv16[4] = quantize16(position_uv[3], dequantization.uv_transform.x, dequantization.uv_transform.z);
+        position_uv16[5] = quantize16(position_uv[4], dequantization.uv_transform.y, dequantization.uv_transform.w);
+        std::memcpy(output, position_uv16.data(), sizeof(position_uv16));
+        output += sizeof(position_uv16);
+
+        // Weights keep a sum of 255, rounding error goes to the strongest bone
+        std::array<uint8_t, Deformer::MAX_BONES_PER_VERTEX> weights = {};
+        std::array<uint8_t, Deformer::MAX_BONES_PER_VERTEX> bone_ids = {};
+        int32_t total = 0;
+        uint8_t strongest = 0;
+        for(uint8_t i=0; i<Deformer::MAX_BONES_PER_VERTEX; i++) {
+            weights[i] = static_cast<uint8_t>(std::min(std::max(deformer.bone_weights[i], 0.0f), 1.0f) * UINT8_MAX + 0.5f);
+            bone_ids[i] = static_cast<uint8_t>(deformer.bone_ids[i]);
+            total += weights[i];
+            if(deformer.bone_weights[i] > deformer.bone_weights[strongest]) strongest = i;
+        }
+        if(total > 0) weights[strongest] = static_cast<uint8_t>(std::min(std::max(weights[strongest] + UINT8_MAX - total, 1), static_cast<int32_t>(UINT8_MAX)));
+
+        std::memcpy(output, weights.data(), sizeof(weights));
+        output += sizeof(weights);
+        std::memcpy(output, bone_ids.data(), sizeof(bone_ids));
+    }
+
+    std::unique_ptr<char> CookedMesh::Cook(std::vector<std::shared_ptr<Mesh>> const& lods, uint32_t& output_size,
+                                           VERTEX_FORMAT format, std::vector<LOD_REPORT>* report, bool optimize)
+    {
+        output_size = 0;
+        if(lods.empty()) return nullptr;
+
+        std::vector<COOKED_LOD> cooked_lods;
+        cooked_lods.reserve(lods.size());
+        for(auto const& lod : lods) cooked_lods.push_back(CookedMesh::CookLOD(*lod, optimize));
+
+        if(report != nullptr) {
+            report->clear();
+            for(auto const& lod : cooked_lods) report->push_back(lod.report);
+        }
+
+        // Compact vertices can't address every bone of large skeletons
+        if(format == COMPACT_VERTEX) {
+            for(auto const& lod : lods) {
+                for(auto const& deformer : lod->deformers) {
+                    for(uint32_t bone_id : deformer.bone_ids) {
+                        if(bone_id > COMPACT_MAX_BONE_ID) format = FLOAT_VERTEX;
+                    }
+                }
+            }
+        }
+
+        SERIALIZED_HEADER header = {};
+        header.vertex_format = format;
+        header.vertex_stride = CookedMesh::GetVertexStride(format);
+        header.dequantization = CookedMesh::ComputeDequantization(cooked_lods);
+        header.lod_count = static_cast<uint32_t>(lods.size());
+        header.index_size = sizeof(uint16_t);
+
+        for(auto const& lod : cooked_lods) {
+            header.max_influences = std::max<uint32_t>(header.max_influences, lod.max_influences);
+            header.vertex_count += static_cast<uint32_t>(lod.vertices.size());
+            header.index_count += static_cast<uint32_t>(lod.indices.size());
+            if(lod.vertices.size() > UINT16_MAX + 1) header.index_size = sizeof(uint32_t);
+        }
+
+        std::string skeleton, texture;
+        for(auto const& lod : lods) {
+            if(skeleton.empty()) skeleton = lod->skeleton;
+            if(texture.empty()) texture = lod->texture;
+        }
+        header.skeleton_length = static_cast<uint32_t>(skeleton.size());
+        header.texture_length = static_cast<uint32_t>(texture.size());
+
+        output_size = static_cast<uint32_t>(sizeof(SERIALIZED_HEADER) + header.lod_count * sizeof(LOD_RANGE)
+                    + header.skeleton_length + header.texture_length
+                    + header.vertex_count * header.vertex_stride + header.index_count * header.index_size);
+
+        std::unique_ptr<char> output(new char[output_size]);
+        char* position = output.get();
+
+        // Header
+        std::memcpy(position, &header, sizeof(SERIALIZED_HEADER));
+        position += sizeof(SERIALIZED_HEADER);
+
+        // LOD ranges
+        LOD_RANGE range = {};
+        for(auto const& lod : cooked_lods) {
+            range.vertex_count = static_cast<uint32_t>(lod.vertices.size());
+            range.index_count = static_cast<uint32_t>(lod.indices.size());
+            std::memcpy(position, &range, sizeof(LOD_RANGE));
+            position += sizeof(LOD_RANGE);
+            range.first_vertex += range.vertex_count;
+            range.first_index += range.index_count;
+        }
+
+        // Names
+        std::memcpy(position, skeleton.data(), skeleton.size());
+        position += skeleton.size();
+        std::memcpy(position, texture.data(), texture.size());
+        position += texture.size();
+
+        // Interleaved vertices
+        for(auto const& lod : cooked_lods) {
+            for(auto const& vertex : lod.vertices) {
+                if(format == COMPACT_VERTEX) CookedMesh::WriteCompactVertex(vertex, header.dequantization, position);
+                else std::memcpy(position, vertex.data(), FLOAT_VERTEX_STRIDE);
+                position += header.vertex_stride;
+            }
+        }
+
+        // Indices, relative to the first vertex of their LOD
+        for(auto const& lod : cooked_lods) {
+            if(header.index_size == sizeof(uint32_t)) {
+                std::memcpy(position, lod.indices.data(), lod.indices.size() * sizeof(uint32_t));
+                position += lod.indices.size() * sizeof(uint32_t);
+            }else{
+                for(uint32_t index : lod.indices) {
+                    uint16_t short_index = static_cast<uint16_t>(index);
+                    std::memcpy(position, &short_index, sizeof(uint16_t));
+                    position += sizeof(uint16_t);
+                }
+            }
+        }
+
+        return output;
+    }
+
+    bool CookedMesh::Deserialize(const char* data, uint32_t size)
+    {
+        this->lods.clear();
+        this->skeleton.clear();
+        this->texture.clear();
+        this->vertex_data = nullptr;
+        this->vertex_data_size = 0;
+        this->index_data = nullptr;
+        this->index_data_size = 0;
+        this->index_size = 0;
+        this->vertex_format = FLOAT_VERTEX;
+        this->max_influences = 0;
+
+        if(data == nullptr || size < sizeof(SERIALIZED_HEADER)) return false;
+
+        SERIALIZED_HEADER header;
+        std::memcpy(&header, data, sizeof(SERIALIZED_HEADER));
+        uint32_t position = sizeof(SERIALIZED_HEADER);
+
+        // A cooked mesh is only valid for the vertex layout it was built with
+        if((header.vertex_format != FLOAT_VERTEX && header.vertex_format != COMPACT_VERTEX)
+        || header.vertex_stride != CookedMesh::GetVertexStride(header.vertex_format)) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "CookedMesh::Deserialize() : vertex stride mismatch" << std::endl;
+            #endif
+            return false;
+        }
+
+        if(header.index_size != sizeof(uint16_t) && header.index_size != sizeof(uint32_t)) return false;
+
+        uint64_t expected_size = static_cast<uint64_t>(position) + static_cast<uint64_t>(header.lod_count) * sizeof(LOD_RANGE)
+                               + header.skeleton_length + header.texture_length
+                               + static_cast<uint64_t>(header.vertex_count) * header.vertex_stride
+                               + static_cast<uint64_t>(header.index_count) * header.index_size;
+        if(expected_size > size) return false;
+
+        // LOD ranges
+        this->lods.resize(header.lod_count);
+        if(header.lod_count > 0) std::memcpy(this->lods.data(), data + position, header.lod_count * sizeof(LOD_RANGE));
+        position += header.lod_count * sizeof(LOD_RANGE);
+
+        // Names
+        this->skeleton = std::string(data + position, data + position + header.skeleton_length);
+        position += header.skeleton_length;
+        this->texture = std::string(data + position, data + position + header.texture_length);
+        position += header.texture_length;
+
+        // Vertices and indices are read in place
+        this->vertex_data = data + position;
+        this->vertex_data_size = header.vertex_count * header.vertex_stride;
+        this->vertex_format = header.vertex_format;
+        this->dequantization = header.dequantization;
+        this->max_influences = static_cast<uint8_t>(std::min<uint32_t>(header.max_influences, Deformer::MAX_BONES_PER_VERTEX));
+        position += this->vertex_data_size;
+
+        this->index_data = data + position;
+        this->index_size = header.index_size;
+        this->index_data_size = header.index_count * header.index_size;
+
+        return true;
+    }
+
+    bool CookedMesh::Deserialize(std::vector<char> data)
+    {
+        this->storage = std::move(data);
+        return this->Deserialize(this->storage.data(), static_cast<uint32_t>(this->storage.size()));
+    }
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <unordered_map>
+#include "../Mesh/Mesh.h"
+#include "../VertexCache/VertexCache.h"
+
+namespace Model
+{
+    /**
+     * GPU ready vertex and index buffers of a group of LODs, built offline by the packer.
+     * Vertices are already interleaved as dynamic_model.vert expects them :
+     * position (vec3), uv (vec2), bone weights (vec4), bone ids (uvec4).
+     * Identical vertices of a LOD are merged and referenced by an index buffer,
+     * indices are relative to the first vertex of their LOD so 16 bits are almost always enough.
+     * The compact format stores 16 bits positions relative to the mesh bounding box, 16 bits UVs,
+     * 8 bits normalized weights and 8 bits bone ids, for 20 bytes per vertex instead of 52.
+     * Triangles and vertices are reordered for the post-transform cache and sequential vertex fetch.
+     * Every LOD is stored one after the other, so loading the whole group is a single copy into mapped memory.
+     */
+    class CookedMesh
+    {
+        public :
+
+            CookedMesh() = default;
+
+            /// Vertex data may point to owned storage, a cooked mesh can only be moved
+            CookedMesh(CookedMesh const&) = delete;
+            CookedMesh& operator=(CookedMesh const&) = delete;
+            CookedMesh(CookedMesh&&) = default;
+            CookedMesh& operator=(CookedMesh&&) = default;
+
+            /// Location of a LOD in the vertex and index buffers
+            struct LOD_RANGE {
+                uint32_t first_vertex;
+                uint32_t vertex_count;
+                uint32_t first_index;
+                uint32_t index_count;
+            };
+
+            /// Vertex cache efficiency of a LOD, before and after reordering
+            struct LOD_REPORT {
+                VertexCache::STATS before;
+                VertexCache::STATS after;
+            };
+
+            /// Interleaved vertex layout
+            enum VERTEX_FORMAT : uint32_t {
+                FLOAT_VERTEX    = 0,    ///< vec3 position, vec2 uv, vec4 weights, uvec4 bone ids
+                COMPACT_VERTEX  = 1     ///< unorm16x4 position, unorm16x2 uv, unorm8x4 weights, uint8x4 bone ids
+            };
+
+            /// Size of one float vertex
+            static const uint32_t FLOAT_VERTEX_STRIDE = sizeof(Maths::Vector3) + sizeof(Maths::Vector2) + sizeof(Deformer);
+
+            /// Size of one compact vertex
+            static const uint32_t COMPACT_VERTEX_STRIDE = 4 * sizeof(uint16_t) + 2 * sizeof(uint16_t) + 4 * sizeof(uint8_t) + 4 * sizeof(uint8_t);
+
+            /// Highest bone id a compact vertex can hold
+            static const uint32_t COMPACT_MAX_BONE_ID = UINT8_MAX;
+
+            /// Restore compact positions and UVs : value = quantized * scale + offset
+            struct DEQUANTIZATION {
+                Maths::Vector4 position_offset;
+                Maths::Vector4 position_scale;
+                Maths::Vector4 uv_transform;    ///< Offset in xy, scale in zw
+            };
+
+            /// Vertex size for a given layout
+            static inline uint32_t GetVertexStride(VERTEX_FORMAT format) { return format == COMPACT_VERTEX ? COMPACT_VERTEX_STRIDE : FLOAT_VERTEX_STRIDE; }
+
+            /// Skeleton used by the meshes
+            std::string skeleton;
+
+            /// Texture used by the meshes
+            std::string texture;
+
+            /// LOD ranges, ordered by level
+            std::vector<LOD_RANGE> lods;
+
+            /**
+             * Interleave and deduplicate the vertices of a group of meshes
+             * @param lods Meshes ordered by LOD level
+             * @param output_size Size of the serialized buffer
+             * @param format Vertex layout, float vertices are used if bone ids don't fit in the compact one
+             * @param report If not nullptr, filled with the vertex cache efficiency of every LOD, left to zero if not optimized
+             * @param optimize Reorder triangles and vertices for the vertex cache, meant for packaging as it is the costly part
+             * @return Serialized cooked mesh, nullptr if lods is empty
+             */
+            static std::unique_ptr<char> Cook(std::vector<std::shared_ptr<Mesh>> const& lods, uint32_t& output_size,
+                                              VERTEX_FORMAT format = FLOAT_VERTEX, std::vector<LOD_REPORT>* report = nullptr, bool optimize = true);
+
+            /**
+             * Read a cooked mesh, vertices and indices are not copied
+             * @param data Serialized cooked mesh, must stay valid as long as GetVertexData() and GetIndexData() are used
+             * @param size Serialized size
+             * @retval true Success
+             * @retval false Truncated or invalid data
+             */
+            bool Deserialize(const char* data, uint32_t size);
+
+            /**
+             * Keep ownership of the serialized buffer, for data that has been decompressed
+             * @param data Serialized cooked mesh
+             * @retval true Success
+             * @retval false Truncated or invalid data
+             */
+            bool Deserialize(std::vector<char> data);
+
+            /// Interleaved vertices of every LOD
+            inline const char* GetVertexData() const { return this->vertex_data; }
+
+            /// Size of interleaved vertices
+            inline uint32_t GetVertexDataSize() const { return this->vertex_data_size; }
+
+            /// Total vertex count
+            inline uint32_t GetVertexCount() const { return this->vertex_data_size / CookedMesh::GetVertexStride(this->vertex_format); }
+
+            /// Vertex layout
+            inline VERTEX_FORMAT GetVertexFormat() const { return this->vertex_format; }
+
+            /// Dequantization of compact vertices, unused by float vertices
+            inline DEQUANTIZATION const& GetDequantization() const { return this->dequantization; }
+
+            /// Indices of every LOD
+            inline const char* GetIndexData() const { return this->index_data; }
+
+            /// Size of indices
+            inline uint32_t GetIndexDataSize() const { return this->index_data_size; }
+
+            /// Size of one index, 2 or 4 bytes
+            inline uint32_t GetIndexSize() const { return this->index_size; }
+
+            /// Highest number of bones influencing a vertex, 0 for rigid meshes
+            inline uint8_t GetMaxInfluences() const { return this->max_influences; }
+
+        private :
+
+            struct SERIALIZED_HEADER {
+                uint32_t vertex_stride;
+                uint32_t vertex_count;
+                uint32_t index_count;
+                uint32_t index_size;
+                uint32_t lod_count;
+                uint32_t skeleton_length;
+                uint32_t texture_length;
+                VERTEX_FORMAT vertex_format;
+                uint32_t max_influences;
+                DEQUANTIZATION dequantization;
+            };
+
+            /// One float vertex, used as deduplication key
+            typedef std::array<char, FLOAT_VERTEX_STRIDE> VERTEX;
+
+            /// FNV-1a hash of an interleaved vertex
+            struct VERTEX_HASH {
+                size_t operator()(VERTEX const& vertex) const;
+            };
+
+            /// Deduplicated LOD
+            struct COOKED_LOD {
+                std::vector<VERTEX> vertices;
+                std::vector<uint32_t> indices;
+                LOD_REPORT report;
+                uint8_t max_influences;
+            };
+
+            /// Owned serialized buffer, empty when data is read in place
+            std::vector<char> storage;
+
+            /// Interleaved vertices
+            const char* vertex_data = nullptr;
+
+            /// Size of interleaved vertices
+            uint32_t vertex_data_size = 0;
+
+            /// Indices
+            const char* index_data = nullptr;
+
+            /// Size of indices
+            uint32_t index_data_size = 0;
+
+            /// Size of one index
+            uint32_t index_size = 0;
+
+            /// Vertex layout
+            VERTEX_FORMAT vertex_format = FLOAT_VERTEX;
+
+            /// Compact vertices dequantization
+            DEQUANTIZATION dequantization;
+
+            /// Highest number of bones influencing a vertex
+            uint8_t max_influences = 0;
+
+            /**
+             * Interleave the vertices of one mesh, merge identical ones and reorder them for the vertex cache.
+             * Influences are sorted by decreasing weight, as the reduced shader variants expect them
+             * @param mesh Source mesh
+             * @param optimize Reorder triangles and vertices, otherwise they keep the order of the source mesh
+             * @return Unique vertices and the indices referencing them
+             */
+            static COOKED_LOD CookLOD(Mesh const& mesh, bool optimize);
+
+            /**
+             * Compute the bounding boxes used to quantize positions and UVs
+             * @param lods Cooked LODs
+             * @return Dequantization of compact vertices
+             */
+            static DEQUANTIZATION ComputeDequantization(std::vector<COOKED_LOD> const& lods);
+
+            /**
+             * Convert a float vertex to the compact layout
+             * @param vertex Float vertex
+             * @param dequantization Bounding boxes of positions and UVs
+             * @param output Write position of the compact vertex
+             */
+            static void WriteCompactVertex(VERTEX const& vertex, DEQUANTIZATION const& dequantization, char* output);
+    };
+}
\ No newline at end of file
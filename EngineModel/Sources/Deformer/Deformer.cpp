@@ -1,5 +1,8 @@
 #include "Deformer.h"
 
+#include <algorithm>
+#include <numeric>
+
 namespace Model
 {
     void Deformer::AddBone(uint32_t id, float weight)
@@ -11,6 +14,13 @@ namespace Model
                 return;
             }
         }
+
+        // Every slot is used : keep the strongest influences
+        auto weakest = std::min_element(this->bone_weights.begin(), this->bone_weights.end());
+        if(weight > *weakest) {
+            this->bone_ids[weakest - this->bone_weights.begin()] = id;
+            *weakest = weight;
+        }
     }
 
     void Deformer::NormalizeWeights()
@@ -26,6 +36,28 @@ namespace Model
                 this->bone_weights[i] = this->bone_weights[i] / total_weight;
     }
 
+    void Deformer::Prune(float threshold)
+    {
+        this->NormalizeWeights();
+
+        std::array<uint8_t, MAX_BONES_PER_VERTEX> order;
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](uint8_t a, uint8_t b) { return this->bone_weights[a] > this->bone_weights[b]; });
+
+        std::array<float, MAX_BONES_PER_VERTEX> weights = {};
+        std::array<uint32_t, MAX_BONES_PER_VERTEX> ids = {};
+        for(uint8_t i=0; i<MAX_BONES_PER_VERTEX; i++) {
+            float weight = this->bone_weights[order[i]];
+            if(weight <= 0.0f || (i > 0 && weight < threshold)) break;
+            weights[i] = weight;
+            ids[i] = this->bone_ids[order[i]];
+        }
+
+        this->bone_weights = weights;
+        this->bone_ids = ids;
+        this->NormalizeWeights();
+    }
+
     std::vector<char> Deformer::Serialize()
     {
         // For safety, just normalize weights before serialization
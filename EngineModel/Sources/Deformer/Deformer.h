@@ -2,6 +2,7 @@
 
 #include <array>
 #include <vector>
+#include <cstdint>
 
 namespace Model
 {
@@ -14,6 +15,9 @@ namespace Model
         public :
             static constexpr uint8_t MAX_BONES_PER_VERTEX  = 4;
 
+            /// Influences lighter than this are dropped by Prune()
+            static constexpr float DEFAULT_WEIGHT_THRESHOLD = 0.01f;
+
             std::array<float, MAX_BONES_PER_VERTEX> bone_weights;
             std::array<uint32_t, MAX_BONES_PER_VERTEX> bone_ids;
 
@@ -22,6 +26,14 @@ namespace Model
 
             void AddBone(uint32_t id, float weight);
             void NormalizeWeights();
+
+            /**
+             * Sort influences by decreasing weight, drop the ones below a threshold and normalize the others,
+             * the strongest influence is always kept. Shaders stop at the first zero weight and reduced
+             * variants only read the first influences, so they rely on this order.
+             * @param threshold Lowest weight kept, relative to the total weight
+             */
+            void Prune(float threshold = DEFAULT_WEIGHT_THRESHOLD);
             inline uint8_t const Size() const { uint8_t size = 0; for(uint8_t i=0; i<this->bone_weights.size(); i++) if(this->bone_weights[i] != 0.0f) size++; return size; } 
             std::vector<char> Serialize();
             uint32_t Deserialize(const char* data);
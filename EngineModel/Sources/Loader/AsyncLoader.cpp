@@ -0,0 +1,73 @@
+#include "AsyncLoader.h"
+
+namespace Model
+{
+    AsyncLoader::AsyncLoader(DataPacker::MappedPackage const& package, uint32_t thread_count) : package(package), stop(false)
+    {
+        if(!thread_count) thread_count = std::thread::hardware_concurrency();
+        if(!thread_count) thread_count = 1;
+
+        this->workers.reserve(thread_count);
+        for(uint32_t i=0; i<thread_count; i++) this->workers.emplace_back(&AsyncLoader::Work, this);
+    }
+
+    AsyncLoader::~AsyncLoader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(this->jobs_mutex);
+            this->stop = true;
+        }
+
+        this->jobs_condition.notify_all();
+        for(auto& worker : this->workers) worker.join();
+    }
+
+    void AsyncLoader::Work()
+    {
+        while(true) {
+            std::function<void()> job;
+
+            {
+                std::unique_lock<std::mutex> lock(this->jobs_mutex);
+                this->jobs_condition.wait(lock, [this]() { return this->stop || !this->jobs.empty(); });
+                if(this->jobs.empty()) return;
+                job = std::move(this->jobs.front());
+                this->jobs.pop();
+            }
+
+            job();
+        }
+    }
+
+    std::shared_future<Tools::IMAGE_MAP> AsyncLoader::RequestImage(std::string const& path)
+    {
+        DataPacker::MappedPackage const& package = this->package;
+        return this->Enqueue<Tools::IMAGE_MAP>([&package, path]() { return Loader::GetImageFromPackage(package, path); });
+    }
+
+    std::shared_future<std::shared_ptr<Mesh>> AsyncLoader::RequestMesh(std::string const& path)
+    {
+        DataPacker::MappedPackage const& package = this->package;
+        return this->Enqueue<std::shared_ptr<Mesh>>([&package, path]() { return Loader::GetMeshFromPackage(package, path); });
+    }
+
+    std::shared_future<std::shared_ptr<CookedMesh>> AsyncLoader::RequestCookedMesh(std::string const& path)
+    {
+        DataPacker::MappedPackage const& package = this->package;
+        return this->Enqueue<std::shared_ptr<CookedMesh>>([&package, path]() { return Loader::GetCookedMeshFromPackage(package, path); });
+    }
+
+    std::shared_future<std::shared_ptr<FlatSkeleton>> AsyncLoader::RequestSkeleton(std::string const& path)
+    {
+        DataPacker::MappedPackage const& package = this->package;
+        return this->Enqueue<std::shared_ptr<FlatSkeleton>>([&package, path]() { return Loader::GetSkeletonFromPackage(package, path); });
+    }
+
+    std::vector<std::shared_future<std::shared_ptr<Mesh>>> AsyncLoader::RequestMeshes(std::vector<std::string> const& paths)
+    {
+        std::vector<std::shared_future<std::shared_ptr<Mesh>>> meshes;
+        meshes.reserve(paths.size());
+        for(auto const& path : paths) meshes.push_back(this->RequestMesh(path));
+        return meshes;
+    }
+}
\ No newline at end of file
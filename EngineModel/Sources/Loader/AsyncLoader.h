@@ -0,0 +1,119 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <queue>
+#include <functional>
+
+#include "Loader.h"
+
+namespace Model
+{
+    /**
+     * Decode package items on a pool of worker threads.
+     * Only decoding happens on the workers : the returned futures hold CPU side objects,
+     * GPU upload of textures and models stays on the thread that consumes the futures.
+     * The package must stay mapped until every requested item has been decoded.
+     */
+    class AsyncLoader
+    {
+        public :
+
+            /**
+             * Start the worker pool
+             * @param package Mapped package to read from
+             * @param thread_count Number of workers, 0 to use one per hardware thread
+             */
+            AsyncLoader(DataPacker::MappedPackage const& package, uint32_t thread_count = 0);
+
+            /// Finish pending jobs and stop the worker pool
+            ~AsyncLoader();
+
+            /// The worker pool can't be copied
+            AsyncLoader(AsyncLoader const&) = delete;
+            AsyncLoader& operator=(AsyncLoader const&) = delete;
+
+            /**
+             * Decode an image in background
+             * @param path Image location inside the package
+             * @return Decoded image, with empty data in case of failure
+             */
+            std::shared_future<Tools::IMAGE_MAP> RequestImage(std::string const& path);
+
+            /**
+             * Deserialize a mesh in background
+             * @param path Mesh location inside the package
+             * @return Deserialized mesh, nullptr in case of failure
+             */
+            std::shared_future<std::shared_ptr<Mesh>> RequestMesh(std::string const& path);
+
+            /**
+             * Read a cooked mesh in background
+             * @param path Cooked mesh location inside the package
+             * @return Cooked mesh, nullptr in case of failure
+             */
+            std::shared_future<std::shared_ptr<CookedMesh>> RequestCookedMesh(std::string const& path);
+
+            /**
+             * Deserialize a skeleton in background
+             * @param path Skeleton location inside the package
+             * @return Flat skeleton, nullptr in case of failure
+             */
+            std::shared_future<std::shared_ptr<FlatSkeleton>> RequestSkeleton(std::string const& path);
+
+            /**
+             * Deserialize a list of meshes in background
+             * @param paths Meshes location inside the package
+             * @return One future per mesh, in the same order as paths
+             */
+            std::vector<std::shared_future<std::shared_ptr<Mesh>>> RequestMeshes(std::vector<std::string> const& paths);
+
+            /// Number of workers
+            inline size_t GetThreadCount() const { return this->workers.size(); }
+
+        private :
+
+            /// Package items are read from
+            DataPacker::MappedPackage const& package;
+
+            /// Worker threads
+            std::vector<std::thread> workers;
+
+            /// Pending jobs
+            std::queue<std::function<void()>> jobs;
+
+            /// Protects jobs and stop
+            std::mutex jobs_mutex;
+
+            /// Wakes workers up when a job is pushed or when the pool stops
+            std::condition_variable jobs_condition;
+
+            /// Workers must exit once the queue is empty
+            bool stop;
+
+            /// Worker main loop
+            void Work();
+
+            /**
+             * Push a job in the queue
+             * @param job Decoding function
+             * @return Future result of the job
+             */
+            template <typename T>
+            std::shared_future<T> Enqueue(std::function<T()> job)
+            {
+                auto task = std::make_shared<std::packaged_task<T()>>(std::move(job));
+                std::shared_future<T> result = task->get_future().share();
+
+                {
+                    std::lock_guard<std::mutex> lock(this->jobs_mutex);
+                    this->jobs.push([task]() { (*task)(); });
+                }
+
+                this->jobs_condition.notify_one();
+                return result;
+            }
+    };
+}
\ No newline at end of file
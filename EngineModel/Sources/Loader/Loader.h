@@ -2,9 +2,13 @@
 
 #include <Tools.h>
 #include <DataPacker.h>
+#include <PackageIndex.h>
+#include <MappedPackage.h>
+#include <Compression.h>
 
 #include "../Mesh/Mesh.h"
-#include "../Skeleton/Skeleton.h"
+#include "../CookedMesh/CookedMesh.h"
+#include "../Skeleton/FlatSkeleton.h"
 
 namespace Model
 {
@@ -15,17 +19,21 @@ namespace Model
             {
                 auto data_tree = DataPacker::Packer::UnpackMemory(data_buffer);
                 auto image_package = DataPacker::Packer::FindPackedItem(data_tree, path);
-                return Tools::LoadImageData(image_package.Data(data_buffer.data()), image_package.size);
+                return Loader::DecodeImage(image_package.Data(data_buffer.data()), image_package.size, image_package.compressed);
             }
 
             static inline std::shared_ptr<Mesh> GetMeshFromPackage(std::vector<char> const& data_buffer, std::string const& path)
             {
                 auto data_tree = DataPacker::Packer::UnpackMemory(data_buffer);
                 auto node = DataPacker::Packer::FindPackedItem(data_tree, path);
-                std::shared_ptr<Mesh> mesh(new Mesh);
-                mesh->Deserialize(node.Data(data_buffer.data()));
+                return Loader::DecodeMesh(node.Data(data_buffer.data()), node.size, node.compressed);
+            }
 
-                return mesh;
+            static inline std::shared_ptr<CookedMesh> GetCookedMeshFromPackage(std::vector<char> const& data_buffer, std::string const& path)
+            {
+                auto data_tree = DataPacker::Packer::UnpackMemory(data_buffer);
+                auto node = DataPacker::Packer::FindPackedItem(data_tree, path);
+                return Loader::DecodeCookedMesh(node.Data(data_buffer.data()), node.size, node.compressed);
             }
 
             /*static inline Mesh::MATERIAL GetMaterialFromPackage(std::vector<char> const& data_buffer, std::string const& path)
@@ -37,17 +45,113 @@ namespace Model
                 return material;
             }*/
 
-            static inline Bone GetSkeletonFromPackage(std::vector<char> const& data_buffer, std::string const& path)
+            static inline std::shared_ptr<FlatSkeleton> GetSkeletonFromPackage(std::vector<char> const& data_buffer, std::string const& path)
             {
                 auto data_tree = DataPacker::Packer::UnpackMemory(data_buffer);
                 auto node = DataPacker::Packer::FindPackedItem(data_tree, path);
-                Bone bone;
-                bone.Deserialize(node.Data(data_buffer.data()));
-                return bone;
+                return Loader::DecodeSkeleton(node.Data(data_buffer.data()), node.size, node.compressed);
+            }
+
+            static inline Tools::IMAGE_MAP GetImageFromPackage(std::vector<char> const& data_buffer, DataPacker::PackageIndex const& index, std::string const& path)
+            {
+                auto entry = index.Find(path);
+                if(entry == nullptr) return {};
+                return Loader::DecodeImage(entry->Data(data_buffer.data()), entry->size, Loader::IsCompressed(*entry));
+            }
+
+            static inline std::shared_ptr<Mesh> GetMeshFromPackage(std::vector<char> const& data_buffer, DataPacker::PackageIndex const& index, std::string const& path)
+            {
+                auto entry = index.Find(path);
+                if(entry == nullptr) return nullptr;
+                return Loader::DecodeMesh(entry->Data(data_buffer.data()), entry->size, Loader::IsCompressed(*entry));
+            }
+
+            static inline std::shared_ptr<CookedMesh> GetCookedMeshFromPackage(std::vector<char> const& data_buffer, DataPacker::PackageIndex const& index, std::string const& path)
+            {
+                auto entry = index.Find(path);
+                if(entry == nullptr) return nullptr;
+                return Loader::DecodeCookedMesh(entry->Data(data_buffer.data()), entry->size, Loader::IsCompressed(*entry));
+            }
+
+            static inline std::shared_ptr<FlatSkeleton> GetSkeletonFromPackage(std::vector<char> const& data_buffer, DataPacker::PackageIndex const& index, std::string const& path)
+            {
+                auto entry = index.Find(path);
+                if(entry == nullptr) return nullptr;
+                return Loader::DecodeSkeleton(entry->Data(data_buffer.data()), entry->size, Loader::IsCompressed(*entry));
+            }
+
+            static inline Tools::IMAGE_MAP GetImageFromPackage(DataPacker::MappedPackage const& package, std::string const& path)
+            {
+                auto entry = package.Index().Find(path);
+                if(entry == nullptr) return {};
+                return Loader::DecodeImage(entry->Data(package.Data()), entry->size, Loader::IsCompressed(*entry));
+            }
+
+            static inline std::shared_ptr<Mesh> GetMeshFromPackage(DataPacker::MappedPackage const& package, std::string const& path)
+            {
+                auto entry = package.Index().Find(path);
+                if(entry == nullptr) return nullptr;
+                return Loader::DecodeMesh(entry->Data(package.Data()), entry->size, Loader::IsCompressed(*entry));
+            }
+
+            static inline std::shared_ptr<CookedMesh> GetCookedMeshFromPackage(DataPacker::MappedPackage const& package, std::string const& path)
+            {
+                auto entry = package.Index().Find(path);
+                if(entry == nullptr) return nullptr;
+                return Loader::DecodeCookedMesh(entry->Data(package.Data()), entry->size, Loader::IsCompressed(*entry));
+            }
+
+            static inline std::shared_ptr<FlatSkeleton> GetSkeletonFromPackage(DataPacker::MappedPackage const& package, std::string const& path)
+            {
+                auto entry = package.Index().Find(path);
+                if(entry == nullptr) return nullptr;
+                return Loader::DecodeSkeleton(entry->Data(package.Data()), entry->size, Loader::IsCompressed(*entry));
             }
 
         private :
-            
+
             Loader(){}
+
+            static inline bool IsCompressed(DataPacker::PackageIndex::ENTRY const& entry) { return (entry.flags & DataPacker::Packer::TOC_COMPRESSED) != 0; }
+
+            static inline Tools::IMAGE_MAP DecodeImage(const char* data, uint32_t size, bool compressed)
+            {
+                std::vector<char> storage;
+                data = DataPacker::Compression::Expand(data, size, compressed, storage);
+                if(data == nullptr) return {};
+                return Tools::LoadImageData(data, size);
+            }
+
+            static inline std::shared_ptr<Mesh> DecodeMesh(const char* data, uint32_t size, bool compressed)
+            {
+                std::vector<char> storage;
+                data = DataPacker::Compression::Expand(data, size, compressed, storage);
+                if(data == nullptr) return nullptr;
+                std::shared_ptr<Mesh> mesh(new Mesh);
+                mesh->Deserialize(data);
+                return mesh;
+            }
+
+            /// Uncompressed vertices are read in place, the package must outlive the cooked mesh
+            static inline std::shared_ptr<CookedMesh> DecodeCookedMesh(const char* data, uint32_t size, bool compressed)
+            {
+                std::vector<char> storage;
+                data = DataPacker::Compression::Expand(data, size, compressed, storage);
+                if(data == nullptr) return nullptr;
+                std::shared_ptr<CookedMesh> cooked_mesh(new CookedMesh);
+                bool success = storage.empty() ? cooked_mesh->Deserialize(data, size) : cooked_mesh->Deserialize(std::move(storage));
+                if(!success) return nullptr;
+                return cooked_mesh;
+            }
+
+            static inline std::shared_ptr<FlatSkeleton> DecodeSkeleton(const char* data, uint32_t size, bool compressed)
+            {
+                std::vector<char> storage;
+                data = DataPacker::Compression::Expand(data, size, compressed, storage);
+                if(data == nullptr) return nullptr;
+                std::shared_ptr<FlatSkeleton> skeleton(new FlatSkeleton);
+                if(!skeleton->Deserialize(data)) return nullptr;
+                return skeleton;
+            }
     };
 }
\ No newline at end of file
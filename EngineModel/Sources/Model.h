@@ -1,4 +1,9 @@
 #pragma once
 
 #include "./Mesh/Mesh.h"
-#include "./Skeleton/Skeleton.h"
\ No newline at end of file
+#include "./CookedMesh/CookedMesh.h"
+#include "./Skeleton/Skeleton.h"
+#include "./Skeleton/FlatSkeleton.h"
+#include "./Skeleton/AnimationBaker.h"
+#include "./Skeleton/AnimationTracks.h"
+#include "./Skeleton/VertexAnimationBaker.h"
\ No newline at end of file
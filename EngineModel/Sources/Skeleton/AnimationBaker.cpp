@@ -0,0 +1,147 @@
+#include "AnimationBaker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace Model
+{
+    AnimationBaker::AnimationBaker(FlatSkeleton const& skeleton, uint8_t frames_per_second)
+        : skeleton(skeleton), time_per_frame(1000 / frames_per_second), bone_per_frame(0), output_size(0)
+    {
+        for(auto const& bone : skeleton.GetBones()) {
+            NODE node;
+            node.parent = bone.parent;
+            node.index = (bone.index < Bone::MAX_BONES_PER_UBO && bone.offset_count > 0) ? bone.index : UINT32_MAX;
+            node.transformation = &bone.transformation;
+            this->nodes.push_back(node);
+        }
+
+        for(auto const& node : this->nodes)
+            if(node.index != UINT32_MAX && node.index + 1 > this->bone_per_frame)
+                this->bone_per_frame = node.index + 1;
+
+        size_t frame_size = this->bone_per_frame * sizeof(Maths::Matrix4x4);
+        auto const& skeleton_animations = skeleton.GetAnimations();
+        for(uint32_t animation_id=0; animation_id<skeleton_animations.size(); animation_id++) {
+            Bone::ANIMATION const& animation = skeleton_animations[animation_id];
+
+            // Round the duration up to the next frame
+            std::chrono::milliseconds final_duration = animation.duration;
+            if(final_duration.count() % this->time_per_frame.count() != 0)
+                final_duration = final_duration + this->time_per_frame - std::chrono::milliseconds(final_duration.count() % this->time_per_frame.count());
+
+            BAKED_ANIMATION baked_animation;
+            baked_animation.name = animation.name;
+            baked_animation.duration = animation.duration;
+            baked_animation.frame_count = static_cast<uint32_t>(final_duration / this->time_per_frame);
+            baked_animation.baked_frames = std::max<uint32_t>(baked_animation.frame_count, 1);
+            baked_animation.offset = this->output_size;
+            baked_animation.size = baked_animation.baked_frames * frame_size;
+            this->output_size += baked_animation.size;
+            this->animations.push_back(baked_animation);
+
+            // Channels of each bone are looked up once per animation
+            for(uint32_t bone_id=0; bone_id<this->nodes.size(); bone_id++)
+                this->tracks.push_back(skeleton.FindTrack(bone_id, animation_id));
+        }
+    }
+
+    void AnimationBaker::Bake(char* output, uint32_t thread_count) const
+    {
+        std::vector<JOB> jobs;
+        for(uint32_t i=0; i<this->animations.size(); i++)
+            for(uint32_t frame=0; frame<this->animations[i].baked_frames; frame+=FRAMES_PER_JOB)
+                jobs.push_back({i, frame, std::min(frame + FRAMES_PER_JOB, this->animations[i].baked_frames), this->animations[i].offset});
+
+        this->Run(jobs, output, thread_count);
+    }
+
+    void AnimationBaker::Bake(uint32_t animation_id, char* output, uint32_t thread_count) const
+    {
+        std::vector<JOB> jobs;
+        for(uint32_t frame=0; frame<this->animations[animation_id].baked_frames; frame+=FRAMES_PER_JOB)
+            jobs.push_back({animation_id, frame, std::min(frame + FRAMES_PER_JOB, this->animations[animation_id].baked_frames), 0});
+
+        this->Run(jobs, output, thread_count);
+    }
+
+    /**
+     * Share frame ranges between threads
+     * @param jobs Frame ranges to evaluate
+     * @param output Output buffer
+     * @param thread_count Number of threads, 0 to use one per hardware thread
+     */
+    void AnimationBaker::Run(std::vector<JOB> const& jobs, char* output, uint32_t thread_count) const
+    {
+        if(!thread_count) thread_count = std::thread::hardware_concurrency();
+        if(!thread_count) thread_count = 1;
+        thread_count = std::min(thread_count, static_cast<uint32_t>(jobs.size()));
+
+        std::atomic<size_t> next_job(0);
+        size_t frame_size = this->bone_per_frame * sizeof(Maths::Matrix4x4);
+
+        auto work = [&]() {
+            // Each thread keeps its own keyframe cursors and bone transformations
+            std::vector<Bone::KEYFRAME_CURSORS> cursors(this->nodes.size(), Bone::KEYFRAME_CURSORS{});
+            std::vector<Maths::Matrix4x4> transformations(this->nodes.size());
+
+            for(size_t i = next_job++; i < jobs.size(); i = next_job++) {
+                JOB const& job = jobs[i];
+                for(uint32_t frame=job.first_frame; frame<job.last_frame; frame++)
+                    this->BakeFrame(job.animation_id, this->time_per_frame * frame, output + job.base_offset + frame * frame_size, cursors, transformations);
+            }
+        };
+
+        // The calling thread takes part in the work
+        std::vector<std::thread> workers;
+        workers.reserve(thread_count > 0 ? thread_count - 1 : 0);
+        for(uint32_t i=1; i<thread_count; i++) workers.emplace_back(work);
+        work();
+        for(auto& worker : workers) worker.join();
+    }
+
+    /**
+     * Evaluate the skeleton at a given time of an animation
+     * @param animation_id Animation to evaluate
+     * @param time Animation progression
+     * @param output Location of the frame in the output buffer
+     * @param cursors Keyframe cursors of each node, kept from one frame to the next
+     * @param transformations[out] Global transformation of each node
+     */
+    void AnimationBaker::BakeFrame(uint32_t animation_id, std::chrono::milliseconds const& time, char* output,
+                                   std::vector<Bone::KEYFRAME_CURSORS>& cursors, std::vector<Maths::Matrix4x4>& transformations) const
+    {
+        FlatSkeleton::TRACK const* const* animation_tracks = this->tracks.data() + animation_id * this->nodes.size();
+
+        for(size_t i=0; i<this->nodes.size(); i++) {
+            NODE const& node = this->nodes[i];
+            FlatSkeleton::TRACK const* anim_transform = animation_tracks[i];
+
+            Maths::Matrix4x4 local_transformation;
+            if(anim_transform != nullptr) {
+                Bone::KEYFRAME_CURSORS& cursor = cursors[i];
+                Maths::Vector3 translation, scaling, rotation;
+                for(uint8_t j=0; j<3; j++) {
+                    FlatSkeleton::KEYS translations = this->skeleton.GetKeys(anim_transform->translations[j]);
+                    FlatSkeleton::KEYS scalings = this->skeleton.GetKeys(anim_transform->scalings[j]);
+                    FlatSkeleton::KEYS rotations = this->skeleton.GetKeys(anim_transform->rotations[j]);
+                    translation[j] = Bone::EvalInterpolation(translations.keys, translations.count, time, cursor[j]);
+                    scaling[j] = Bone::EvalInterpolation(scalings.keys, scalings.count, time, cursor[3 + j], {std::chrono::milliseconds(0), 1.0f});
+                    rotation[j] = Bone::EvalInterpolation(rotations.keys, rotations.count, time, cursor[6 + j]) * DEGREES_TO_RADIANS;
+                }
+
+                local_transformation = Maths::Transform(translation, Maths::Quaternion::FromEuler(rotation, Maths::Matrix4x4::EULER_ORDER::ZYX), scaling).ToMatrix();
+            }else{
+                local_transformation = *node.transformation;
+            }
+
+            // Parents are always evaluated before their children
+            if(node.parent == UINT32_MAX) transformations[i] = local_transformation;
+            else transformations[i] = transformations[node.parent] * local_transformation;
+
+            if(node.index != UINT32_MAX)
+                *reinterpret_cast<Maths::Matrix4x4*>(output + node.index * sizeof(Maths::Matrix4x4)) = transformations[i];
+        }
+    }
+}
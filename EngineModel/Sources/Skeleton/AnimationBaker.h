@@ -0,0 +1,96 @@
+#pragma once
+
+#include "FlatSkeleton.h"
+
+namespace Model
+{
+    /**
+     * Bake the animations of a skeleton into bone matrix palettes.
+     * Bones of the flat skeleton already come after their parent, the channels of each bone are looked up once,
+     * frames are then evaluated in parallel and written straight into a preallocated output buffer.
+     * The skeleton must outlive the baker.
+     */
+    class AnimationBaker
+    {
+        public :
+
+            /// Location of a baked animation in the output buffer
+            struct BAKED_ANIMATION {
+                std::string name;
+                std::chrono::milliseconds duration;
+                uint32_t frame_count;   // Frame count as seen by the shaders
+                uint32_t baked_frames;  // Frames written in the output buffer, at least one
+                size_t offset;          // Position of the first frame in the output buffer, in bytes
+                size_t size;            // Size of the baked frames, in bytes
+            };
+
+            /**
+             * Compute the layout of the output buffer
+             * @param skeleton Flat skeleton
+             * @param frames_per_second Sampling rate of the animations
+             */
+            AnimationBaker(FlatSkeleton const& skeleton, uint8_t frames_per_second = 30);
+
+            /// Number of matrices in a frame
+            inline uint32_t GetBonePerFrame() const { return this->bone_per_frame; }
+
+            /// Size of the buffer needed to bake every animation
+            inline size_t GetOutputSize() const { return this->output_size; }
+
+            /// Animations in the same order as FlatSkeleton::GetAnimations
+            inline std::vector<BAKED_ANIMATION> const& GetAnimations() const { return this->animations; }
+
+            /**
+             * Bake every animation
+             * @param output Buffer of at least GetOutputSize() bytes, filled with zeros
+             * @param thread_count Number of threads, 0 to use one per hardware thread
+             */
+            void Bake(char* output, uint32_t thread_count = 0) const;
+
+            /**
+             * Bake a single animation at the beginning of the output buffer
+             * @param animation_id Index of the animation in GetAnimations()
+             * @param output Buffer of at least GetAnimations()[animation_id].size bytes, filled with zeros
+             * @param thread_count Number of threads, 0 to use one per hardware thread
+             */
+            void Bake(uint32_t animation_id, char* output, uint32_t thread_count = 0) const;
+
+        private :
+
+            /// Frames evaluated by a thread before it picks up another job
+            static constexpr uint32_t FRAMES_PER_JOB = 8;
+
+            /// Flattened bone
+            struct NODE {
+                uint32_t parent;        // Index of the parent node, UINT32_MAX for the root
+                uint32_t index;         // Bone index in the palette, UINT32_MAX if the bone is not written
+                Maths::Matrix4x4 const* transformation;
+            };
+
+            /// Contiguous range of frames of an animation
+            struct JOB {
+                uint32_t animation_id;
+                uint32_t first_frame;
+                uint32_t last_frame;
+                size_t base_offset;
+            };
+
+            /// Keyframes are read from the skeleton
+            FlatSkeleton const& skeleton;
+
+            /// Bones in depth first order
+            std::vector<NODE> nodes;
+
+            /// Animation channels of each node, animations.size() * nodes.size() entries, nullptr if the bone is not animated
+            std::vector<FlatSkeleton::TRACK const*> tracks;
+
+            std::vector<BAKED_ANIMATION> animations;
+            std::chrono::milliseconds time_per_frame;
+            uint32_t bone_per_frame;
+            size_t output_size;
+
+            void Run(std::vector<JOB> const& jobs, char* output, uint32_t thread_count) const;
+            void BakeFrame(uint32_t animation_id, std::chrono::milliseconds const& time, char* output,
+                           std::vector<Bone::KEYFRAME_CURSORS>& cursors, std::vector<Maths::Matrix4x4>& transformations) const;
+    };
+}
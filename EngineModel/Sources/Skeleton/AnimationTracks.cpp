@@ -0,0 +1,195 @@
+#include "AnimationTracks.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Model
+{
+    AnimationTracks::AnimationTracks(FlatSkeleton const& skeleton, uint8_t frames_per_second)
+        : time_per_frame(1000 / frames_per_second), bone_per_frame(0)
+    {
+        for(auto const& bone : skeleton.GetBones()) {
+            NODE node = {};
+            node.parent = bone.parent == UINT32_MAX ? -1 : static_cast<int32_t>(bone.parent);
+            node.bone_index = (bone.index < Bone::MAX_BONES_PER_UBO && bone.offset_count > 0) ? bone.index : UINT32_MAX;
+            node.rest = bone.transformation;
+            this->nodes.push_back(node);
+        }
+
+        for(auto const& node : this->nodes)
+            if(node.bone_index != UINT32_MAX && node.bone_index + 1 > this->bone_per_frame)
+                this->bone_per_frame = node.bone_index + 1;
+
+        auto const& skeleton_animations = skeleton.GetAnimations();
+        for(uint32_t animation_id=0; animation_id<skeleton_animations.size(); animation_id++) {
+            Bone::ANIMATION const& animation = skeleton_animations[animation_id];
+
+            // Same frame count as the baked palettes, so that both modes share the per unit animation data
+            std::chrono::milliseconds final_duration = animation.duration;
+            if(final_duration.count() % this->time_per_frame.count() != 0)
+                final_duration = final_duration + this->time_per_frame - std::chrono::milliseconds(final_duration.count() % this->time_per_frame.count());
+
+            ANIMATION track_animation;
+            track_animation.name = animation.name;
+            track_animation.duration = animation.duration;
+            track_animation.frame_count = static_cast<uint32_t>(final_duration / this->time_per_frame);
+            this->animations.push_back(track_animation);
+
+            for(uint32_t bone_id=0; bone_id<this->nodes.size(); bone_id++) {
+                NODE_TRACKS node_tracks = {};
+
+                FlatSkeleton::TRACK const* anim_transform = skeleton.FindTrack(bone_id, animation_id);
+                if(anim_transform != nullptr) {
+                    node_tracks.animated = 1;
+                    this->AddVectorChannel(AnimationTracks::GetChannel(skeleton, anim_transform->translations), {}, node_tracks.translation_first, node_tracks.translation_count,
+                                           node_tracks.translation_min, node_tracks.translation_extent);
+                    this->AddRotationChannel(AnimationTracks::GetChannel(skeleton, anim_transform->rotations), node_tracks.rotation_first, node_tracks.rotation_count);
+                    this->AddVectorChannel(AnimationTracks::GetChannel(skeleton, anim_transform->scalings), {std::chrono::milliseconds(0), 1.0f}, node_tracks.scaling_first, node_tracks.scaling_count,
+                                           node_tracks.scaling_min, node_tracks.scaling_extent);
+                }
+
+                this->tracks.push_back(node_tracks);
+            }
+        }
+    }
+
+    /**
+     * Keyframes of the three components of a channel
+     */
+    std::array<FlatSkeleton::KEYS, 3> AnimationTracks::GetChannel(FlatSkeleton const& skeleton, std::array<FlatSkeleton::CHANNEL, 3> const& channel)
+    {
+        return {skeleton.GetKeys(channel[0]), skeleton.GetKeys(channel[1]), skeleton.GetKeys(channel[2])};
+    }
+
+    /**
+     * Union of the key times of the three components of a channel,
+     * a key at time zero is added when the channel starts later, to keep the ramp from the base value
+     */
+    std::vector<std::chrono::milliseconds> AnimationTracks::MergeKeyTimes(std::array<FlatSkeleton::KEYS, 3> const& channel)
+    {
+        std::vector<std::chrono::milliseconds> times;
+        for(auto const& component : channel)
+            for(auto const& keyframe : component)
+                times.push_back(keyframe.time);
+
+        if(times.empty()) return times;
+
+        std::sort(times.begin(), times.end());
+        times.erase(std::unique(times.begin(), times.end()), times.end());
+        if(times.front().count() > 0) times.insert(times.begin(), std::chrono::milliseconds(0));
+
+        return times;
+    }
+
+    /**
+     * Quantize a translation or scaling channel
+     * @param channel Keyframes of each component
+     * @param base Value of a component before its first key
+     * @param first[out] Index of the first key
+     * @param count[out] Number of keys, zero if the channel is not animated
+     * @param range_min[out] Lowest value of each component
+     * @param range_extent[out] Range of each component
+     */
+    void AnimationTracks::AddVectorChannel(std::array<FlatSkeleton::KEYS, 3> const& channel, KEYFRAME const& base,
+                                           uint32_t& first, uint32_t& count, Maths::Vector4& range_min, Maths::Vector4& range_extent)
+    {
+        first = static_cast<uint32_t>(this->key_times.size());
+        count = 0;
+        range_min = {base.value, base.value, base.value, 0.0f};
+        range_extent = {};
+
+        std::vector<std::chrono::milliseconds> times = this->MergeKeyTimes(channel);
+        if(times.empty()) return;
+
+        // Times are sorted, the cursors only move forward
+        std::array<uint32_t, 3> cursors = {};
+        std::vector<Maths::Vector3> values(times.size());
+        for(size_t i=0; i<times.size(); i++)
+            for(uint8_t j=0; j<3; j++)
+                values[i][j] = Bone::EvalInterpolation(channel[j].keys, channel[j].count, times[i], cursors[j], base);
+
+        // A constant channel keeps a single key
+        if(std::all_of(values.begin(), values.end(), [&](Maths::Vector3 const& value) { return value == values[0]; })) {
+            times.resize(1);
+            values.resize(1);
+        }
+
+        Maths::Vector3 range_max = values[0];
+        range_min = {values[0].x, values[0].y, values[0].z, 0.0f};
+        for(auto const& value : values) {
+            for(uint8_t j=0; j<3; j++) {
+                range_min[j] = std::min(range_min[j], value[j]);
+                range_max[j] = std::max(range_max[j], value[j]);
+            }
+        }
+        for(uint8_t j=0; j<3; j++) range_extent[j] = range_max[j] - range_min[j];
+
+        for(size_t i=0; i<times.size(); i++) {
+            KEY_VALUE key_value = {};
+            for(uint8_t j=0; j<3; j++) {
+                float normalized = range_extent[j] > 0.0f ? (values[i][j] - range_min[j]) / range_extent[j] : 0.0f;
+                key_value[j] = static_cast<uint16_t>(std::lround(std::min(std::max(normalized, 0.0f), 1.0f) * 65535.0f));
+            }
+
+            this->key_times.push_back(static_cast<uint32_t>(times[i].count()));
+            this->key_values.push_back(key_value);
+        }
+
+        count = static_cast<uint32_t>(times.size());
+    }
+
+    /**
+     * Convert an euler angles channel to quantized quaternions
+     * @param channel Keyframes of each angle, in degrees
+     * @param first[out] Index of the first key
+     * @param count[out] Number of keys, zero if the channel is not animated
+     */
+    void AnimationTracks::AddRotationChannel(std::array<FlatSkeleton::KEYS, 3> const& channel, uint32_t& first, uint32_t& count)
+    {
+        first = static_cast<uint32_t>(this->key_times.size());
+        count = 0;
+
+        std::vector<std::chrono::milliseconds> times = this->MergeKeyTimes(channel);
+        if(times.empty()) return;
+
+        std::vector<KEY_VALUE> values;
+        Maths::Quaternion previous;
+        std::array<uint32_t, 3> cursors = {};
+        for(auto const& time : times) {
+            Maths::Vector3 rotation;
+            for(uint8_t j=0; j<3; j++) rotation[j] = Bone::EvalInterpolation(channel[j].keys, channel[j].count, time, cursors[j]) * DEGREES_TO_RADIANS;
+
+            Maths::Quaternion quaternion = Maths::Quaternion::FromEuler(rotation, Maths::Matrix4x4::EULER_ORDER::ZYX);
+
+            // Keep consecutive keys in the same hemisphere so that the shader interpolates along the shortest path
+            if(quaternion.Dot(previous) < 0.0f) quaternion = -quaternion;
+            previous = quaternion;
+
+            KEY_VALUE key_value;
+            for(uint8_t j=0; j<4; j++)
+                key_value[j] = static_cast<uint16_t>(static_cast<int16_t>(std::lround(std::min(std::max(quaternion[j], -1.0f), 1.0f) * 32767.0f)));
+            values.push_back(key_value);
+        }
+
+        // A constant channel keeps a single key
+        if(std::all_of(values.begin(), values.end(), [&](KEY_VALUE const& value) { return value == values[0]; })) {
+            times.resize(1);
+            values.resize(1);
+        }
+
+        for(size_t i=0; i<times.size(); i++) {
+            this->key_times.push_back(static_cast<uint32_t>(times[i].count()));
+            this->key_values.push_back(values[i]);
+        }
+
+        count = static_cast<uint32_t>(times.size());
+    }
+
+    size_t AnimationTracks::GetSize() const
+    {
+        return this->nodes.size() * sizeof(NODE)
+             + this->tracks.size() * sizeof(NODE_TRACKS)
+             + this->key_times.size() * sizeof(uint32_t)
+             + this->key_values.size() * sizeof(KEY_VALUE);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "FlatSkeleton.h"
+
+namespace Model
+{
+    /**
+     * Compress the animations of a skeleton into GPU sampled tracks.
+     * Every animated bone gets one translation, one rotation and one scaling channel,
+     * translations and scalings are quantized to 16 bits within the range of the track,
+     * rotations are converted to quaternions and quantized to 16 bits per component.
+     * The bone palette is then evaluated per unit at any time by a compute shader.
+     */
+    class AnimationTracks
+    {
+        public :
+
+            /// Flattened bone, matches std430 layout
+            struct NODE {
+                int32_t parent;             // Index of the parent node, -1 for the root
+                uint32_t bone_index;        // Bone index in the palette, UINT32_MAX if the bone is not written
+                uint32_t padding[2];
+                Maths::Matrix4x4 rest;      // Transformation used when the bone is not animated
+            };
+
+            /// Channels of a bone in an animation, matches std430 layout
+            struct NODE_TRACKS {
+                uint32_t animated;
+                uint32_t translation_first;
+                uint32_t translation_count;
+                uint32_t rotation_first;
+                uint32_t rotation_count;
+                uint32_t scaling_first;
+                uint32_t scaling_count;
+                uint32_t padding;
+                Maths::Vector4 translation_min;
+                Maths::Vector4 translation_extent;
+                Maths::Vector4 scaling_min;
+                Maths::Vector4 scaling_extent;
+            };
+
+            /// Quantized key value : unorm16 x 3 for translations and scalings, snorm16 x 4 for rotations
+            typedef std::array<uint16_t, 4> KEY_VALUE;
+
+            struct ANIMATION {
+                std::string name;
+                std::chrono::milliseconds duration;
+                uint32_t frame_count;       // Frame count as seen by the shaders
+            };
+
+            /**
+             * Compress the animation channels
+             * @param skeleton Flat skeleton
+             * @param frames_per_second Rate used to express static poses and frame counts
+             */
+            AnimationTracks(FlatSkeleton const& skeleton, uint8_t frames_per_second = 30);
+
+            /// Number of matrices in a palette
+            inline uint32_t GetBonePerFrame() const { return this->bone_per_frame; }
+
+            /// Number of flattened bones
+            inline uint32_t GetNodeCount() const { return static_cast<uint32_t>(this->nodes.size()); }
+
+            /// Animations in the same order as FlatSkeleton::GetAnimations
+            inline std::vector<ANIMATION> const& GetAnimations() const { return this->animations; }
+
+            /// Channels of each node, animation_id * node count + node_id
+            inline std::vector<NODE_TRACKS> const& GetTracks() const { return this->tracks; }
+
+            /// Key times in milliseconds
+            inline std::vector<uint32_t> const& GetKeyTimes() const { return this->key_times; }
+
+            /// Quantized key values, one per key time
+            inline std::vector<KEY_VALUE> const& GetKeyValues() const { return this->key_values; }
+
+            /// Flattened bones, parents are indices in this array
+            inline std::vector<NODE> const& GetNodes() const { return this->nodes; }
+
+            /// Duration of a frame in milliseconds, used for static poses
+            inline float GetFrameDuration() const { return static_cast<float>(this->time_per_frame.count()); }
+
+            /// Total size of the tracks once uploaded, in bytes
+            size_t GetSize() const;
+
+        private :
+
+            std::vector<NODE> nodes;
+            std::vector<NODE_TRACKS> tracks;
+            std::vector<uint32_t> key_times;
+            std::vector<KEY_VALUE> key_values;
+            std::vector<ANIMATION> animations;
+            std::chrono::milliseconds time_per_frame;
+            uint32_t bone_per_frame;
+
+            void AddVectorChannel(std::array<FlatSkeleton::KEYS, 3> const& channel, KEYFRAME const& base,
+                                  uint32_t& first, uint32_t& count, Maths::Vector4& range_min, Maths::Vector4& range_extent);
+            void AddRotationChannel(std::array<FlatSkeleton::KEYS, 3> const& channel, uint32_t& first, uint32_t& count);
+            static std::array<FlatSkeleton::KEYS, 3> GetChannel(FlatSkeleton const& skeleton, std::array<FlatSkeleton::CHANNEL, 3> const& channel);
+            static std::vector<std::chrono::milliseconds> MergeKeyTimes(std::array<FlatSkeleton::KEYS, 3> const& channel);
+    };
+}
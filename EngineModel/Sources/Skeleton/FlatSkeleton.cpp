@@ -0,0 +1,219 @@
+#include "FlatSkeleton.h"
+
+#include <algorithm>
+
+namespace Model
+{
+    uint32_t FlatSkeleton::Deserialize(const char* data)
+    {
+        this->name.clear();
+        this->bones.clear();
+        this->tracks.clear();
+        this->offsets.clear();
+        this->keyframes.clear();
+        this->animations.clear();
+        this->mesh_names.clear();
+
+        uint32_t offset = 0;
+
+        // Bones still waiting for children : bone id and number of children left to read
+        std::vector<std::pair<uint32_t, uint16_t>> pending;
+
+        do {
+            BONE bone;
+            bone.parent = pending.empty() ? UINT32_MAX : pending.back().first;
+            if(!pending.empty()) pending.back().second--;
+
+            // Only the name of the root is kept, it names the skeleton
+            uint8_t name_length = data[offset];
+            offset++;
+            if(this->bones.empty()) this->name = std::string(data + offset, data + offset + name_length);
+            offset += name_length;
+
+            std::memcpy(&bone.index, data + offset, sizeof(uint32_t));
+            offset += sizeof(uint32_t);
+            std::memcpy(&bone.transformation, data + offset, sizeof(Maths::Matrix4x4));
+            offset += sizeof(Maths::Matrix4x4);
+
+            // Animations
+            uint16_t animations_count;
+            std::memcpy(&animations_count, data + offset, sizeof(uint16_t));
+            offset += sizeof(uint16_t);
+
+            bool compact = (animations_count & Bone::COMPACT_ANIMATIONS) != 0;
+            animations_count &= static_cast<uint16_t>(~Bone::COMPACT_ANIMATIONS);
+
+            bone.first_track = static_cast<uint32_t>(this->tracks.size());
+            bone.track_count = animations_count;
+            for(uint16_t i=0; i<animations_count; i++) {
+                uint8_t animation_name_length = data[offset];
+                offset++;
+
+                TRACK track;
+                track.animation = this->InternAnimation(data + offset, animation_name_length);
+                offset += animation_name_length;
+
+                std::chrono::milliseconds& duration = this->animations[track.animation].duration;
+                for(uint8_t j=0; j<3; j++) offset += this->ReadChannel(data + offset, compact, track.translations[j], duration);
+                for(uint8_t j=0; j<3; j++) offset += this->ReadChannel(data + offset, compact, track.rotations[j], duration);
+                for(uint8_t j=0; j<3; j++) offset += this->ReadChannel(data + offset, compact, track.scalings[j], duration);
+                this->tracks.push_back(track);
+            }
+
+            // Bone offsets
+            uint16_t offsets_count;
+            std::memcpy(&offsets_count, data + offset, sizeof(uint16_t));
+            offset += sizeof(uint16_t);
+
+            bone.first_offset = static_cast<uint32_t>(this->offsets.size());
+            bone.offset_count = offsets_count;
+            for(uint16_t i=0; i<offsets_count; i++) {
+                uint8_t mesh_name_length = data[offset];
+                offset++;
+
+                OFFSET bone_offset;
+                bone_offset.mesh = this->InternMesh(data + offset, mesh_name_length);
+                offset += mesh_name_length;
+                std::memcpy(&bone_offset.matrix, data + offset, sizeof(Maths::Matrix4x4));
+                offset += sizeof(Maths::Matrix4x4);
+                this->offsets.push_back(bone_offset);
+            }
+
+            // Children follow their parent
+            uint16_t child_count;
+            std::memcpy(&child_count, data + offset, sizeof(uint16_t));
+            offset += sizeof(uint16_t);
+
+            uint32_t bone_id = static_cast<uint32_t>(this->bones.size());
+            this->bones.push_back(bone);
+            if(child_count) pending.push_back({bone_id, child_count});
+            while(!pending.empty() && !pending.back().second) pending.pop_back();
+
+        } while(!pending.empty());
+
+        return offset;
+    }
+
+    /**
+     * Append the keyframes of a channel to the keyframe array
+     * @param data Serialized channel
+     * @param compact Channel written by Bone::SerializeChannel, legacy format otherwise
+     * @param channel[out] Range of the keyframes
+     * @param duration[in,out] Duration of the animation, extended up to the last keyframe
+     * @return Number of bytes read
+     */
+    uint32_t FlatSkeleton::ReadChannel(const char* data, bool compact, CHANNEL& channel, std::chrono::milliseconds& duration)
+    {
+        uint32_t offset = 0;
+        channel.first = static_cast<uint32_t>(this->keyframes.size());
+
+        if(!compact) {
+            std::memcpy(&channel.count, data + offset, sizeof(uint32_t));
+            offset += sizeof(uint32_t);
+
+            for(uint32_t i=0; i<channel.count; i++) {
+                uint64_t time;
+                float value;
+                std::memcpy(&time, data + offset, sizeof(uint64_t));
+                offset += sizeof(uint64_t);
+                std::memcpy(&value, data + offset, sizeof(float));
+                offset += sizeof(float);
+                this->keyframes.emplace_back(std::chrono::milliseconds(time), value);
+            }
+
+        }else if(data[offset] & Bone::CHANNEL_CONSTANT) {
+            offset += sizeof(uint8_t);
+            uint32_t time;
+            float value;
+            std::memcpy(&time, data + offset, sizeof(uint32_t));
+            offset += sizeof(uint32_t);
+            std::memcpy(&value, data + offset, sizeof(float));
+            offset += sizeof(float);
+            this->keyframes.emplace_back(std::chrono::milliseconds(time), value);
+            channel.count = 1;
+
+        }else{
+            bool wide_time = (data[offset] & Bone::CHANNEL_WIDE_TIME) != 0;
+            offset += sizeof(uint8_t);
+            std::memcpy(&channel.count, data + offset, sizeof(uint32_t));
+            offset += sizeof(uint32_t);
+            this->keyframes.resize(this->keyframes.size() + channel.count);
+            KEYFRAME* keys = this->keyframes.data() + channel.first;
+
+            // Times, then values
+            std::chrono::milliseconds time(0);
+            for(uint32_t i=0; i<channel.count; i++) {
+                if(wide_time) {
+                    uint32_t absolute_time;
+                    std::memcpy(&absolute_time, data + offset, sizeof(uint32_t));
+                    offset += sizeof(uint32_t);
+                    time = std::chrono::milliseconds(absolute_time);
+                }else{
+                    uint16_t delta_time;
+                    std::memcpy(&delta_time, data + offset, sizeof(uint16_t));
+                    offset += sizeof(uint16_t);
+                    time += std::chrono::milliseconds(delta_time);
+                }
+                keys[i].time = time;
+            }
+
+            for(uint32_t i=0; i<channel.count; i++) {
+                std::memcpy(&keys[i].value, data + offset, sizeof(float));
+                offset += sizeof(float);
+            }
+        }
+
+        for(auto const& keyframe : this->GetKeys(channel))
+            duration = std::max(duration, keyframe.time);
+
+        return offset;
+    }
+
+    /**
+     * Index of an animation, added on first use
+     * @param animation_name Name, not null terminated
+     * @param length Name length
+     */
+    uint32_t FlatSkeleton::InternAnimation(const char* animation_name, uint8_t length)
+    {
+        for(uint32_t i=0; i<this->animations.size(); i++)
+            if(!this->animations[i].name.compare(0, std::string::npos, animation_name, length)) return i;
+
+        this->animations.push_back({std::string(animation_name, length), std::chrono::milliseconds(0)});
+        return static_cast<uint32_t>(this->animations.size() - 1);
+    }
+
+    /**
+     * Index of a mesh name, added on first use
+     * @param mesh_name Name, not null terminated
+     * @param length Name length
+     */
+    uint32_t FlatSkeleton::InternMesh(const char* mesh_name, uint8_t length)
+    {
+        for(uint32_t i=0; i<this->mesh_names.size(); i++)
+            if(!this->mesh_names[i].compare(0, std::string::npos, mesh_name, length)) return i;
+
+        this->mesh_names.emplace_back(mesh_name, length);
+        return static_cast<uint32_t>(this->mesh_names.size() - 1);
+    }
+
+    FlatSkeleton::TRACK const* FlatSkeleton::FindTrack(uint32_t bone_id, uint32_t animation_id) const
+    {
+        BONE const& bone = this->bones[bone_id];
+        for(uint32_t i=bone.first_track; i<bone.first_track + bone.track_count; i++)
+            if(this->tracks[i].animation == animation_id) return &this->tracks[i];
+        return nullptr;
+    }
+
+    void FlatSkeleton::BuildBoneOffsetsSBO(std::vector<char>& offsets, std::vector<char>& offsets_ids, std::map<std::string, std::pair<uint32_t, uint32_t>>& dynamic_offsets, uint32_t alignment) const
+    {
+        std::map<std::string, std::map<uint8_t, Maths::Matrix4x4 const*>> prepared_bone_offsets_ubo;
+        for(auto const& bone : this->bones) {
+            if(bone.index >= Bone::MAX_BONES_PER_UBO) continue;
+            for(uint32_t i=bone.first_offset; i<bone.first_offset + bone.offset_count; i++)
+                prepared_bone_offsets_ubo[this->mesh_names[this->offsets[i].mesh]][static_cast<uint8_t>(bone.index)] = &this->offsets[i].matrix;
+        }
+
+        Bone::BuildOffsetsSBO(offsets, offsets_ids, prepared_bone_offsets_ubo, dynamic_offsets, alignment);
+    }
+}
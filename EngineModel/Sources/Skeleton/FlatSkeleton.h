@@ -0,0 +1,111 @@
+#pragma once
+
+#include "Skeleton.h"
+
+namespace Model
+{
+    /**
+     * Read-only skeleton stored in a handful of contiguous arrays instead of a tree of bones.
+     * Bones are in depth first order, every bone comes after its parent and references it by index.
+     * Animation and mesh names are interned, the keyframes of every channel follow each other in a single array.
+     * It is read in one pass from a serialized bone tree, without any per bone allocation,
+     * and is meant to be moved around rather than copied.
+     */
+    class FlatSkeleton
+    {
+        public :
+
+            /// Keyframes of one component, range of the keyframe array
+            struct CHANNEL {
+                uint32_t first;
+                uint32_t count;
+            };
+
+            /// Channels of a bone in an animation
+            struct TRACK {
+                uint32_t animation;                     // Index in GetAnimations()
+                std::array<CHANNEL, 3> translations;
+                std::array<CHANNEL, 3> rotations;
+                std::array<CHANNEL, 3> scalings;
+            };
+
+            /// Bone offset of a mesh
+            struct OFFSET {
+                uint32_t mesh;                          // Index in GetMeshNames()
+                Maths::Matrix4x4 matrix;
+            };
+
+            struct BONE {
+                uint32_t parent;                        // Index of the parent bone, UINT32_MAX for the root
+                uint32_t index;                         // Bone index given by the packer
+                uint32_t first_track;                   // Range of the track array
+                uint32_t track_count;
+                uint32_t first_offset;                  // Range of the offset array, sorted by mesh name
+                uint32_t offset_count;
+                Maths::Matrix4x4 transformation;
+            };
+
+            /// Keyframes of a channel, iterable
+            struct KEYS {
+                KEYFRAME const* keys;
+                uint32_t count;
+                inline KEYFRAME const* begin() const { return this->keys; }
+                inline KEYFRAME const* end() const { return this->keys + this->count; }
+                inline bool empty() const { return !this->count; }
+            };
+
+            FlatSkeleton() = default;
+            FlatSkeleton(FlatSkeleton&&) = default;
+            FlatSkeleton& operator=(FlatSkeleton&&) = default;
+            FlatSkeleton(FlatSkeleton const&) = delete;
+            FlatSkeleton& operator=(FlatSkeleton const&) = delete;
+
+            /**
+             * Read a bone tree serialized by Bone::Serialize, compact or legacy channels
+             * @param data Serialized root bone
+             * @return Number of bytes read
+             */
+            uint32_t Deserialize(const char* data);
+
+            /// Name of the root bone, used as skeleton name
+            inline std::string const& GetName() const { return this->name; }
+
+            /// Bones in depth first order
+            inline std::vector<BONE> const& GetBones() const { return this->bones; }
+
+            /// Animations in the same order as Bone::ListAnimations
+            inline std::vector<Bone::ANIMATION> const& GetAnimations() const { return this->animations; }
+
+            /// Interned mesh names, referenced by bone offsets
+            inline std::vector<std::string> const& GetMeshNames() const { return this->mesh_names; }
+
+            /// Bone offsets of every bone
+            inline std::vector<OFFSET> const& GetOffsets() const { return this->offsets; }
+
+            /// Keyframes of a channel
+            inline KEYS GetKeys(CHANNEL const& channel) const { return {this->keyframes.data() + channel.first, channel.count}; }
+
+            /**
+             * Channels of a bone in an animation
+             * @return nullptr if the animation doesn't move the bone
+             */
+            TRACK const* FindTrack(uint32_t bone_id, uint32_t animation_id) const;
+
+            /// Same output as Bone::BuildBoneOffsetsSBO
+            void BuildBoneOffsetsSBO(std::vector<char>& offsets, std::vector<char>& offsets_ids, std::map<std::string, std::pair<uint32_t, uint32_t>>& dynamic_offsets, uint32_t alignment = 0) const;
+
+        private :
+
+            std::string name;
+            std::vector<BONE> bones;
+            std::vector<TRACK> tracks;
+            std::vector<OFFSET> offsets;
+            std::vector<KEYFRAME> keyframes;
+            std::vector<Bone::ANIMATION> animations;
+            std::vector<std::string> mesh_names;
+
+            uint32_t ReadChannel(const char* data, bool compact, CHANNEL& channel, std::chrono::milliseconds& duration);
+            uint32_t InternAnimation(const char* animation_name, uint8_t length);
+            uint32_t InternMesh(const char* mesh_name, uint8_t length);
+    };
+}
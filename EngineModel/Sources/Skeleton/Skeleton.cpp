@@ -1,4 +1,8 @@
 #include "Skeleton.h"
+#include "AnimationBaker.h"
+#include "FlatSkeleton.h"
+
+#include <algorithm>
 
 namespace Model
 {
@@ -11,11 +15,11 @@ namespace Model
 
         // Taille des animations
         for(auto const& anim : this->animations) {
-            serialized_size += static_cast<uint32_t>(sizeof(uint8_t) + anim.first.size() + sizeof(uint32_t) * 9);
+            serialized_size += static_cast<uint32_t>(sizeof(uint8_t) + anim.first.size());
             for(uint8_t i=0; i<3; i++) {
-                serialized_size += static_cast<uint32_t>(anim.second.translations[i].size() * (sizeof(uint64_t) + sizeof(float)));
-                serialized_size += static_cast<uint32_t>(anim.second.rotations[i].size() * (sizeof(uint64_t) + sizeof(float)));
-                serialized_size += static_cast<uint32_t>(anim.second.scalings[i].size() * (sizeof(uint64_t) + sizeof(float)));
+                serialized_size += Bone::ChannelSerializedSize(anim.second.translations[i]);
+                serialized_size += Bone::ChannelSerializedSize(anim.second.rotations[i]);
+                serialized_size += Bone::ChannelSerializedSize(anim.second.scalings[i]);
             }
         }
 
@@ -51,11 +55,11 @@ namespace Model
         offset += sizeof(uint32_t);
 
         // Insertion de la transformation
-        *reinterpret_cast<Maths::Matrix4x4*>(output.data() + offset) = this->transformation;
+        std::memcpy(output.data() + offset, &this->transformation, sizeof(Maths::Matrix4x4));
         offset += sizeof(Maths::Matrix4x4);
 
         // Insertion des animations (keyframes)
-        uint16_t animations_count = static_cast<uint16_t>(this->animations.size());
+        uint16_t animations_count = static_cast<uint16_t>(this->animations.size() | Bone::COMPACT_ANIMATIONS);
         *reinterpret_cast<uint16_t*>(output.data() + offset) = animations_count;
         offset += sizeof(uint16_t);
 
@@ -69,40 +73,16 @@ namespace Model
             offset += static_cast<uint32_t>(animation.first.size());
 
             // Translations
-            for(uint8_t i=0; i<3; i++) {
-                *reinterpret_cast<uint32_t*>(output.data() + offset) = static_cast<uint32_t>(animation.second.translations[i].size());
-                offset += sizeof(uint32_t);
-                for(auto const& keyframe : animation.second.translations[i]) {
-                    *reinterpret_cast<uint64_t*>(output.data() + offset) = keyframe.time.count();
-                    offset += sizeof(uint64_t);
-                    *reinterpret_cast<float*>(output.data() + offset) = keyframe.value;
-                    offset += sizeof(float);
-                }
-            }
+            for(uint8_t i=0; i<3; i++)
+                offset += Bone::SerializeChannel(animation.second.translations[i], output.data() + offset);
 
             //Rotations
-            for(uint8_t i=0; i<3; i++) {
-                *reinterpret_cast<uint32_t*>(output.data() + offset) = static_cast<uint32_t>(animation.second.rotations[i].size());
-                offset += sizeof(uint32_t);
-                for(auto const& keyframe : animation.second.rotations[i]) {
-                    *reinterpret_cast<uint64_t*>(output.data() + offset) = keyframe.time.count();
-                    offset += sizeof(uint64_t);
-                    *reinterpret_cast<float*>(output.data() + offset) = keyframe.value;
-                    offset += sizeof(float);
-                }
-            }
+            for(uint8_t i=0; i<3; i++)
+                offset += Bone::SerializeChannel(animation.second.rotations[i], output.data() + offset);
 
             //Scalings
-            for(uint8_t i=0; i<3; i++) {
-                *reinterpret_cast<uint32_t*>(output.data() + offset) = static_cast<uint32_t>(animation.second.scalings[i].size());
-                offset += sizeof(uint32_t);
-                for(auto const& keyframe : animation.second.scalings[i]) {
-                    *reinterpret_cast<uint64_t*>(output.data() + offset) = keyframe.time.count();
-                    offset += sizeof(uint64_t);
-                    *reinterpret_cast<float*>(output.data() + offset) = keyframe.value;
-                    offset += sizeof(float);
-                }
-            }
+            for(uint8_t i=0; i<3; i++)
+                offset += Bone::SerializeChannel(animation.second.scalings[i], output.data() + offset);
         }
 
         // Insertion des offsets
@@ -120,7 +100,7 @@ namespace Model
             offset += static_cast<uint32_t>(offset_matrix.first.size());
 
             // Matrice
-            *reinterpret_cast<Maths::Matrix4x4*>(output.data() + offset) = offset_matrix.second;
+            std::memcpy(output.data() + offset, &offset_matrix.second, sizeof(Maths::Matrix4x4));
             offset += sizeof(Maths::Matrix4x4);
         }
 
@@ -154,15 +134,19 @@ namespace Model
         offset += sizeof(uint32_t);
 
         // Transformation
-        this->transformation = *reinterpret_cast<const Maths::Matrix4x4*>(data + offset);
+        std::memcpy(&this->transformation, data + offset, sizeof(Maths::Matrix4x4));
         offset += sizeof(Maths::Matrix4x4);
 
         // Animations (keyframes)
         uint16_t animations_count = *reinterpret_cast<const uint16_t*>(data + offset);
         offset += sizeof(uint16_t);
 
+        // Les anciens paquets stockent chaque KeyFrame sur 12 octets
+        bool compact = (animations_count & Bone::COMPACT_ANIMATIONS) != 0;
+        animations_count &= static_cast<uint16_t>(~Bone::COMPACT_ANIMATIONS);
+        auto deserialize_channel = compact ? &Bone::DeserializeChannel : &Bone::DeserializeLegacyChannel;
+
         for(uint16_t i=0; i<animations_count; i++) {
-            ANIM_TRANSFORM animation;
 
             // Nom de l'animation
             uint8_t animation_name_length = data[offset];
@@ -170,43 +154,19 @@ namespace Model
             std::string animation_name = std::string(data + offset, data + offset + animation_name_length);
             offset += animation_name_length;
 
+            ANIM_TRANSFORM& animation = this->animations[animation_name];
+
             // Translations
-            for(uint8_t i=0; i<3; i++) {
-                animation.translations[i].resize(*reinterpret_cast<const uint32_t*>(data + offset));
-                offset += sizeof(uint32_t);
-                for(auto& keyframe : animation.translations[i]) {
-                    keyframe.time = std::chrono::milliseconds(*reinterpret_cast<const uint64_t*>(data + offset));
-                    offset += sizeof(uint64_t);
-                    keyframe.value = *reinterpret_cast<const float*>(data + offset);
-                    offset += sizeof(float);
-                }
-            }
+            for(uint8_t i=0; i<3; i++)
+                offset += deserialize_channel(animation.translations[i], data + offset);
 
             // Rotations
-            for(uint8_t i=0; i<3; i++) {
-                animation.rotations[i].resize(*reinterpret_cast<const uint32_t*>(data + offset));
-                offset += sizeof(uint32_t);
-                for(auto& keyframe : animation.rotations[i]) {
-                    keyframe.time = std::chrono::milliseconds(*reinterpret_cast<const uint64_t*>(data + offset));
-                    offset += sizeof(uint64_t);
-                    keyframe.value = *reinterpret_cast<const float*>(data + offset);
-                    offset += sizeof(float);
-                }
-            }
+            for(uint8_t i=0; i<3; i++)
+                offset += deserialize_channel(animation.rotations[i], data + offset);
 
             // Scalings
-            for(uint8_t i=0; i<3; i++) {
-                animation.scalings[i].resize(*reinterpret_cast<const uint32_t*>(data + offset));
-                offset += sizeof(uint32_t);
-                for(auto& keyframe : animation.scalings[i]) {
-                    keyframe.time = std::chrono::milliseconds(*reinterpret_cast<const uint64_t*>(data + offset));
-                    offset += sizeof(uint64_t);
-                    keyframe.value = *reinterpret_cast<const float*>(data + offset);
-                    offset += sizeof(float);
-                }
-            }
-
-            this->animations[animation_name] = animation;
+            for(uint8_t i=0; i<3; i++)
+                offset += deserialize_channel(animation.scalings[i], data + offset);
         }
 
         // Lecture des offsets
@@ -220,7 +180,7 @@ namespace Model
             std::string offset_name = std::string(data + offset, data + offset + offset_name_length);
             offset += offset_name_length;
 
-            this->offsets[offset_name] = *reinterpret_cast<const Maths::Matrix4x4*>(data + offset);
+            std::memcpy(&this->offsets[offset_name], data + offset, sizeof(Maths::Matrix4x4));
             offset += sizeof(Maths::Matrix4x4);
         }
 
@@ -236,6 +196,210 @@ namespace Model
         return offset;
     }
 
+    /**
+     * Taille d'une courbe aprs srialisation
+     * @param keyframes Liste des KeyFrames de la courbe
+     */
+    uint32_t Bone::ChannelSerializedSize(std::vector<KEYFRAME> const& keyframes)
+    {
+        if(keyframes.size() == 1) return static_cast<uint32_t>(sizeof(uint8_t) + sizeof(uint32_t) + sizeof(float));
+
+        bool wide_time = false;
+        std::chrono::milliseconds previous_time(0);
+        for(auto const& keyframe : keyframes) {
+            if(keyframe.time < previous_time || (keyframe.time - previous_time).count() > UINT16_MAX) wide_time = true;
+            previous_time = keyframe.time;
+        }
+
+        return static_cast<uint32_t>(sizeof(uint8_t) + sizeof(uint32_t) + keyframes.size() * ((wide_time ? sizeof(uint32_t) : sizeof(uint16_t)) + sizeof(float)));
+    }
+
+    /**
+     * Srialisation compacte d'une courbe :
+     * les temps sont stocks sous forme d'carts sur 16 bits et une courbe constante ne contient qu'une valeur
+     * @param keyframes Liste des KeyFrames de la courbe
+     * @param output[out] Emplacement de la courbe dans le buffer de sortie
+     * @return Nombre d'octets crits
+     */
+    uint32_t Bone::SerializeChannel(std::vector<KEYFRAME> const& keyframes, char* output)
+    {
+        uint32_t offset = sizeof(uint8_t);
+
+        if(keyframes.size() == 1) {
+            output[0] = Bone::CHANNEL_CONSTANT;
+            *reinterpret_cast<uint32_t*>(output + offset) = static_cast<uint32_t>(keyframes[0].time.count());
+            offset += sizeof(uint32_t);
+            *reinterpret_cast<float*>(output + offset) = keyframes[0].value;
+            offset += sizeof(float);
+            return offset;
+        }
+
+        uint32_t size = Bone::ChannelSerializedSize(keyframes);
+        bool wide_time = size > sizeof(uint8_t) + sizeof(uint32_t) + keyframes.size() * (sizeof(uint16_t) + sizeof(float));
+        output[0] = wide_time ? Bone::CHANNEL_WIDE_TIME : 0;
+
+        *reinterpret_cast<uint32_t*>(output + offset) = static_cast<uint32_t>(keyframes.size());
+        offset += sizeof(uint32_t);
+
+        // Temps
+        std::chrono::milliseconds previous_time(0);
+        for(auto const& keyframe : keyframes) {
+            if(wide_time) {
+                *reinterpret_cast<uint32_t*>(output + offset) = static_cast<uint32_t>(keyframe.time.count());
+                offset += sizeof(uint32_t);
+            }else{
+                *reinterpret_cast<uint16_t*>(output + offset) = static_cast<uint16_t>((keyframe.time - previous_time).count());
+                offset += sizeof(uint16_t);
+            }
+            previous_time = keyframe.time;
+        }
+
+        // Valeurs
+        for(auto const& keyframe : keyframes) {
+            *reinterpret_cast<float*>(output + offset) = keyframe.value;
+            offset += sizeof(float);
+        }
+
+        return offset;
+    }
+
+    /**
+     * Lecture d'une courbe srialise par @ref SerializeChannel
+     * @param keyframes[out] Liste des KeyFrames de la courbe
+     * @param data Emplacement de la courbe
+     * @return Nombre d'octets lus
+     */
+    uint32_t Bone::DeserializeChannel(std::vector<KEYFRAME>& keyframes, const char* data)
+    {
+        uint8_t flags = data[0];
+        uint32_t offset = sizeof(uint8_t);
+
+        if(flags & Bone::CHANNEL_CONSTANT) {
+            keyframes.resize(1);
+            keyframes[0].time = std::chrono::milliseconds(*reinterpret_cast<const uint32_t*>(data + offset));
+            offset += sizeof(uint32_t);
+            keyframes[0].value = *reinterpret_cast<const float*>(data + offset);
+            offset += sizeof(float);
+            return offset;
+        }
+
+        keyframes.resize(*reinterpret_cast<const uint32_t*>(data + offset));
+        offset += sizeof(uint32_t);
+
+        // Temps
+        std::chrono::milliseconds time(0);
+        for(auto& keyframe : keyframes) {
+            if(flags & Bone::CHANNEL_WIDE_TIME) {
+                time = std::chrono::milliseconds(*reinterpret_cast<const uint32_t*>(data + offset));
+                offset += sizeof(uint32_t);
+            }else{
+                time += std::chrono::milliseconds(*reinterpret_cast<const uint16_t*>(data + offset));
+                offset += sizeof(uint16_t);
+            }
+            keyframe.time = time;
+        }
+
+        // Valeurs
+        for(auto& keyframe : keyframes) {
+            keyframe.value = *reinterpret_cast<const float*>(data + offset);
+            offset += sizeof(float);
+        }
+
+        return offset;
+    }
+
+    /**
+     * Lecture d'une courbe stocke dans l'ancien format : temps sur 64 bits et valeur pour chaque KeyFrame
+     * @param keyframes[out] Liste des KeyFrames de la courbe
+     * @param data Emplacement de la courbe
+     * @return Nombre d'octets lus
+     */
+    uint32_t Bone::DeserializeLegacyChannel(std::vector<KEYFRAME>& keyframes, const char* data)
+    {
+        uint32_t offset = 0;
+        keyframes.resize(*reinterpret_cast<const uint32_t*>(data + offset));
+        offset += sizeof(uint32_t);
+
+        for(auto& keyframe : keyframes) {
+            keyframe.time = std::chrono::milliseconds(*reinterpret_cast<const uint64_t*>(data + offset));
+            offset += sizeof(uint64_t);
+            keyframe.value = *reinterpret_cast<const float*>(data + offset);
+            offset += sizeof(float);
+        }
+
+        return offset;
+    }
+
+    /**
+     * Suppression des KeyFrames redondantes de toutes les animations de l'arbre
+     * @param translation_tolerance Erreur maximale tolre sur les translations
+     * @param rotation_tolerance Erreur maximale tolre sur les rotations, en degrs
+     * @param scaling_tolerance Erreur maximale tolre sur les mises  l'chelle
+     */
+    void Bone::ReduceKeyFrames(float translation_tolerance, float rotation_tolerance, float scaling_tolerance)
+    {
+        for(auto& animation : this->animations) {
+            for(uint8_t i=0; i<3; i++) {
+                Bone::ReduceKeyFrames(animation.second.translations[i], translation_tolerance);
+                Bone::ReduceKeyFrames(animation.second.rotations[i], rotation_tolerance);
+                Bone::ReduceKeyFrames(animation.second.scalings[i], scaling_tolerance);
+            }
+        }
+
+        for(auto& child : this->children)
+            child.ReduceKeyFrames(translation_tolerance, rotation_tolerance, scaling_tolerance);
+    }
+
+    /**
+     * Suppression des KeyFrames qui peuvent tre retrouves par interpolation linaire de leurs voisines.
+     * La premire et la dernire KeyFrame sont conserves, une courbe constante qui commence au temps 0 est rduite
+     *  une seule KeyFrame place au temps de la dernire afin de conserver la dure de l'animation.
+     * @param keyframes[in,out] Liste des KeyFrames tries par temps
+     * @param tolerance cart maximal tolr entre la courbe d'origine et la courbe rduite, aux temps des KeyFrames supprimes
+     */
+    void Bone::ReduceKeyFrames(std::vector<KEYFRAME>& keyframes, float tolerance)
+    {
+        if(keyframes.size() < 2) return;
+
+        // Courbe constante, avant la premire KeyFrame la valeur est interpole depuis l'tat initial :
+        // la rduction  une seule KeyFrame n'est possible que si la courbe commence au temps 0
+        bool constant = keyframes[0].time.count() == 0;
+        for(auto const& keyframe : keyframes) {
+            if(std::abs(keyframe.value - keyframes[0].value) > tolerance) {
+                constant = false;
+                break;
+            }
+        }
+
+        if(constant) {
+            keyframes = {{keyframes.back().time, keyframes[0].value}};
+            return;
+        }
+
+        // On prolonge chaque segment tant que les KeyFrames qu'il recouvre restent dans la tolrance
+        std::vector<KEYFRAME> reduced = {keyframes[0]};
+        uint32_t anchor = 0;
+        for(uint32_t end=2; end<keyframes.size(); end++) {
+            KEYFRAME const& source = keyframes[anchor];
+            KEYFRAME const& dest = keyframes[end];
+            float duration = static_cast<float>((dest.time - source.time).count());
+
+            bool fits = true;
+            for(uint32_t i=anchor+1; i<end && fits; i++) {
+                float ratio = duration > 0.0f ? static_cast<float>((keyframes[i].time - source.time).count()) / duration : 0.0f;
+                fits = std::abs(Maths::Interpolate(source.value, dest.value, ratio) - keyframes[i].value) <= tolerance;
+            }
+
+            if(!fits) {
+                anchor = end - 1;
+                reduced.push_back(keyframes[anchor]);
+            }
+        }
+
+        reduced.push_back(keyframes.back());
+        keyframes = std::move(reduced);
+    }
+
     /**
      * Compte le nombre d'os contenus dans l'arbre
      */
@@ -260,7 +424,7 @@ namespace Model
     {
         this->BuildSkeletonSBO(skeleton, IDENTITY_MATRIX, Bone::MAX_BONES_PER_UBO);
 
-        std::map<std::string, std::map<uint8_t, Maths::Matrix4x4*>> prepared_bone_offsets_ubo;
+        std::map<std::string, std::map<uint8_t, Maths::Matrix4x4 const*>> prepared_bone_offsets_ubo;
         this->PrepareOffsetSBO(static_cast<uint8_t>(skeleton.size() / sizeof(Maths::Matrix4x4)), prepared_bone_offsets_ubo);
         this->BuildOffsetsSBO(offsets, offsets_ids, prepared_bone_offsets_ubo, dynamic_offsets, alignment);
     }
@@ -273,7 +437,7 @@ namespace Model
      */
     void Bone::BuildBoneOffsetsSBO(std::vector<char>& offsets, std::vector<char>& offsets_ids, std::map<std::string, std::pair<uint32_t, uint32_t>>& dynamic_offsets, uint32_t alignment)
     {
-        std::map<std::string, std::map<uint8_t, Maths::Matrix4x4*>> prepared_bone_offsets_ubo;
+        std::map<std::string, std::map<uint8_t, Maths::Matrix4x4 const*>> prepared_bone_offsets_ubo;
         this->PrepareOffsetSBO(Bone::MAX_BONES_PER_UBO, prepared_bone_offsets_ubo);
         this->BuildOffsetsSBO(offsets, offsets_ids, prepared_bone_offsets_ubo, dynamic_offsets, alignment);
     }
@@ -283,13 +447,13 @@ namespace Model
      * @param max_count[in] limite de bone offsets pour un mesh
      * @param prepared_ubo[out] Cl : nom du mesh, Valeur : std::map => Cl : indice du bone, Valeur bone offset du mesh
      */
-    void Bone::PrepareOffsetSBO(uint8_t max_count, std::map<std::string, std::map<uint8_t, Maths::Matrix4x4*>>& prepared_ubo)
+    void Bone::PrepareOffsetSBO(uint8_t max_count, std::map<std::string, std::map<uint8_t, Maths::Matrix4x4 const*>>& prepared_ubo) const
     {
         if(this->index < max_count && !this->offsets.empty())
-            for(auto& offset : this->offsets)
+            for(auto const& offset : this->offsets)
                 prepared_ubo[offset.first][this->index] = &offset.second;
 
-        for(auto& child : this->children)
+        for(auto const& child : this->children)
             child.PrepareOffsetSBO(max_count, prepared_ubo);
     }
 
@@ -301,7 +465,7 @@ namespace Model
      * @param mesh_ubo_count[out] Renvoie la liste des offsets des donnes associes  chaque mesh (ces donnes sont toutes contenus dans le buffer offsets)
      * @param alignment[in] Alignement mmoire des bone offsets (minUniformBufferOffsetAlignment)
      */
-    void Bone::BuildOffsetsSBO(std::vector<char>& offsets, std::vector<char>& offsets_ids, std::map<std::string, std::map<uint8_t, Maths::Matrix4x4*>> const& prepared_bone_offsets_ubo,
+    void Bone::BuildOffsetsSBO(std::vector<char>& offsets, std::vector<char>& offsets_ids, std::map<std::string, std::map<uint8_t, Maths::Matrix4x4 const*>> const& prepared_bone_offsets_ubo,
                                std::map<std::string, std::pair<uint32_t, uint32_t>>& dynamic_offsets, uint32_t alignment)
     {
         uint32_t offsets_output_size = 0;
@@ -361,45 +525,6 @@ namespace Model
             child.BuildSkeletonSBO(skeleton, bone_transfromation, max_count);
     }
 
-    /**
-     * Cration du squelette positionn  un instant donn d'une animation
-     * @param skeleton[out] Buffer contenant le squelette
-     * @param parent_transformation[in] Transformation du bone parent
-     * @param max_count[in] limite du nombre de bones dansle squelette
-     * @param time Avancement de l'animation dans le temps
-     * @param animation Animation souhaite
-     */
-    void Bone::BuildSkeletonSBO(std::vector<char>& skeleton, Maths::Matrix4x4 const& parent_transformation, uint8_t max_count,
-                                std::chrono::milliseconds const& time, std::string const& animation, uint32_t base_offset)
-    {
-        // valuation de la transformation au temps indiqu
-        Maths::Matrix4x4 bone_transfromation;
-        if(this->animations.count(animation)) {
-            Maths::Vector3 translation, scaling, rotation;
-            for(uint8_t i=0; i<3; i++) {
-                translation[i] = this->EvalInterpolation(this->animations[animation].translations[i], time);
-                scaling[i] = this->EvalInterpolation(this->animations[animation].scalings[i], time, {std::chrono::milliseconds(0), 1.0f});
-                rotation[i] = this->EvalInterpolation(this->animations[animation].rotations[i], time) * DEGREES_TO_RADIANS;
-            }
-
-            Maths::Matrix4x4 anim_transformation = Maths::Matrix4x4::TranslationMatrix(translation) * Maths::Matrix4x4::EulerRotation(IDENTITY_MATRIX, rotation, Maths::Matrix4x4::EULER_ORDER::ZYX) * Maths::Matrix4x4::ScalingMatrix(scaling);
-            bone_transfromation = parent_transformation * anim_transformation;
-        }else{
-            bone_transfromation = parent_transformation * this->transformation;
-        }
-
-        // criture du bone
-        if(this->index < max_count && !this->offsets.empty()) {
-            uint32_t skeleton_offset = base_offset + this->index * sizeof(Maths::Matrix4x4);
-            if(skeleton.size() < skeleton_offset + sizeof(Maths::Matrix4x4)) skeleton.resize(skeleton_offset + sizeof(Maths::Matrix4x4));
-            *reinterpret_cast<Maths::Matrix4x4*>(skeleton.data() + skeleton_offset) = bone_transfromation;
-        }
-
-        // Traitement rcursif sur tous les enfants
-        for(auto& child : this->children)
-            child.BuildSkeletonSBO(skeleton, bone_transfromation, max_count, time, animation, base_offset);
-    }
-
     /**
      * Calcule la dure totale de l'animation en cherchant la KeyFrame la plus avance dans le temps
      * @param animation Nom de l'animation dont on souhaite connaitre la dure
@@ -426,19 +551,32 @@ namespace Model
         return total_duration;
     }
 
+    /**
+     * Cration du buffer contenant toutes les frames d'une animation, les frames sont values en parallle
+     * @param skeleton[out] Buffer contenant les frames
+     * @param animation Animation souhaite
+     * @param frame_count[out] Nombre de frames de l'animation
+     * @param bone_per_frame[out] Nombre de bones dans une frame
+     * @param frames_per_second Frquence d'chantillonnage de l'animation
+     */
     void Bone::BuildAnimationSBO(std::vector<char>& skeleton, std::string const& animation, uint32_t& frame_count, uint32_t& bone_per_frame, uint8_t frames_per_second)
     {
-        std::chrono::milliseconds total_duration = this->GetAnimationTotalDuration(animation);
-        std::chrono::milliseconds time_per_frame(1000 / frames_per_second);
-        std::chrono::milliseconds final_duration = total_duration;
-        if(final_duration.count() % time_per_frame.count() != 0)
-            final_duration =  final_duration + time_per_frame - std::chrono::milliseconds(final_duration.count() % time_per_frame.count());
-
-        this->BuildSkeletonSBO(skeleton, IDENTITY_MATRIX, Bone::MAX_BONES_PER_UBO, std::chrono::milliseconds(0), animation, 0);
-        frame_count = static_cast<uint32_t>(final_duration /  time_per_frame);
-        bone_per_frame = static_cast<uint32_t>(skeleton.size() / sizeof(Maths::Matrix4x4));
-        for(uint16_t i=1; i<frame_count; i++)
-            this->BuildSkeletonSBO(skeleton, IDENTITY_MATRIX, Bone::MAX_BONES_PER_UBO, time_per_frame * i, animation, static_cast<uint32_t>(skeleton.size()));
+        // Le baker lit la forme aplatie du squelette
+        FlatSkeleton flat_skeleton;
+        flat_skeleton.Deserialize(this->Serialize().data());
+        AnimationBaker baker(flat_skeleton, frames_per_second);
+        bone_per_frame = baker.GetBonePerFrame();
+        frame_count = 0;
+
+        auto const& animations = baker.GetAnimations();
+        for(uint32_t i=0; i<animations.size(); i++) {
+            if(animations[i].name == animation) {
+                frame_count = animations[i].frame_count;
+                skeleton.resize(skeleton.size() + animations[i].size);
+                baker.Bake(i, skeleton.data() + skeleton.size() - animations[i].size);
+                return;
+            }
+        }
     }
 
     /**
@@ -479,32 +617,75 @@ namespace Model
     }
 
     /**
-     * Interpolation d'une KeyFrame : Calcul d'un tat intermdiaire entre une KeyFrame et la suivante afin de crer une animation sans discontinuit.
+     * Recherche de la KeyFrame qui suit un instant donn.
+     * La recherche reprend  la position de la lecture prcdente : quand le temps avance d'une lecture  l'autre
+     * seules quelques KeyFrames sont parcourues, sinon on se rabat sur une recherche dichotomique.
+     * @param keyframes Liste des KeyFrames tries par temps
+     * @param count Nombre de KeyFrames
+     * @param time Stade d'avancement de l'animation
+     * @param cursor[in,out] Position de la lecture prcdente, mise  jour
+     * @return Indice de la premire KeyFrame strictement postrieure  time, count si aucune
+     */
+    uint32_t Bone::FindKeyFrame(KEYFRAME const* keyframes, uint32_t count, std::chrono::milliseconds const& time, uint32_t& cursor)
+    {
+        static const uint32_t max_linear_steps = 4;
+        if(cursor > count || (cursor > 0 && keyframes[cursor - 1].time > time)) cursor = 0;
+
+        // Lecture squentielle
+        for(uint32_t i=0; i<max_linear_steps && cursor < count; i++) {
+            if(keyframes[cursor].time > time) return cursor;
+            cursor++;
+        }
+        if(cursor == count) return cursor;
+
+        // Saut en avant
+        auto next = std::upper_bound(keyframes + cursor, keyframes + count, time,
+                                     [](std::chrono::milliseconds const& value, KEYFRAME const& keyframe) { return value < keyframe.time; });
+        cursor = static_cast<uint32_t>(next - keyframes);
+        return cursor;
+    }
+
+    /**
+     * Interpolation d'une KeyFrame, sans mmoriser la position de lecture
      * @param keyframes Liste des KeyFrames composant un mouvement
      * @param time Stade d'avancement de l'animation
      * @param base Stade initial de l'animation
      */
     float Bone::EvalInterpolation(std::vector<KEYFRAME> const& keyframes, std::chrono::milliseconds const& time, KEYFRAME const& base)
     {
-        if(keyframes.size() == 0) return base.value;
-        if(keyframes.size() == 1) return keyframes[0].value;
-        if(time > keyframes[keyframes.size() - 1].time) return keyframes[keyframes.size() - 1].value;
-
-        uint32_t source_key = UINT32_MAX;
-        uint32_t dest_key = UINT32_MAX;
-
-        // TODO : Amlioration => Recherche dichotomique
-        for(uint32_t i=0; i<keyframes.size(); i++) {
-            auto& keyframe = keyframes[i];
-            if(keyframe.time <= time) {
-                source_key = i;
-            } else {
-                dest_key = i;
-                break;
-            }
-        }
+        uint32_t cursor = 0;
+        return Bone::EvalInterpolation(keyframes, time, cursor, base);
+    }
+
+    /**
+     * Interpolation d'une KeyFrame : Calcul d'un tat intermdiaire entre une KeyFrame et la suivante afin de crer une animation sans discontinuit.
+     * @param keyframes Liste des KeyFrames composant un mouvement
+     * @param time Stade d'avancement de l'animation
+     * @param cursor[in,out] Position de la lecture prcdente
+     * @param base Stade initial de l'animation
+     */
+    float Bone::EvalInterpolation(std::vector<KEYFRAME> const& keyframes, std::chrono::milliseconds const& time, uint32_t& cursor, KEYFRAME const& base)
+    {
+        return Bone::EvalInterpolation(keyframes.data(), static_cast<uint32_t>(keyframes.size()), time, cursor, base);
+    }
+
+    /**
+     * Interpolation d'une KeyFrame stocke dans un tableau contigu
+     * @param keyframes Premire KeyFrame du mouvement
+     * @param count Nombre de KeyFrames
+     * @param time Stade d'avancement de l'animation
+     * @param cursor[in,out] Position de la lecture prcdente
+     * @param base Stade initial de l'animation
+     */
+    float Bone::EvalInterpolation(KEYFRAME const* keyframes, uint32_t count, std::chrono::milliseconds const& time, uint32_t& cursor, KEYFRAME const& base)
+    {
+        if(count == 0) return base.value;
+        if(count == 1) return keyframes[0].value;
+        if(time >= keyframes[count - 1].time) return keyframes[count - 1].value;
+
+        uint32_t dest_key = Bone::FindKeyFrame(keyframes, count, time, cursor);
 
-        KEYFRAME const& source_keyframe = (source_key == UINT32_MAX) ? base : keyframes[source_key];
+        KEYFRAME const& source_keyframe = (dest_key == 0) ? base : keyframes[dest_key - 1];
         KEYFRAME const& dest_keyframe = keyframes[dest_key];
 
         std::chrono::milliseconds current_key_duration = dest_keyframe.time - source_keyframe.time;
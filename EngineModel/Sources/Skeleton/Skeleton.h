@@ -27,9 +27,16 @@ namespace Model
 
     class Bone
     {
+        friend class AnimationBaker;
+        friend class AnimationTracks;
+        friend class FlatSkeleton;
+
         public :
             static constexpr uint8_t MAX_BONES_PER_UBO  = 100;
 
+            // Bit de poids fort du nombre d'animations : les courbes sont srialises sous forme compacte
+            static constexpr uint16_t COMPACT_ANIMATIONS = 0x8000;
+
             struct ANIMATION {
                 std::string name;
                 std::chrono::milliseconds duration;
@@ -47,6 +54,8 @@ namespace Model
             uint32_t Deserialize(const char* data);
             uint32_t SerializedSize() const;
             uint32_t Count() const;
+            void ReduceKeyFrames(float translation_tolerance = 0.001f, float rotation_tolerance = 0.01f, float scaling_tolerance = 0.0001f);
+            static void ReduceKeyFrames(std::vector<KEYFRAME>& keyframes, float tolerance);
 
             // TODO : crire directement dans le UBO final plutt que de passer par un buffer temporaire
             std::vector<ANIMATION> ListAnimations() const;
@@ -59,11 +68,26 @@ namespace Model
         private :
 
             void BuildSkeletonSBO(std::vector<char>& skeleton, Maths::Matrix4x4 const& parent_transformation, uint8_t max_count);
-            void BuildSkeletonSBO(std::vector<char>& skeleton, Maths::Matrix4x4 const& parent_transformation, uint8_t max_count,
-                                  std::chrono::milliseconds const& time, std::string const& animation, uint32_t base_offset);
-            void BuildOffsetsSBO(std::vector<char>& offsets, std::vector<char>& offsets_ids, std::map<std::string, std::map<uint8_t, Maths::Matrix4x4*>> const& prepared_bone_offsets_ubo,
-                                 std::map<std::string, std::pair<uint32_t, uint32_t>>& sub_segment_sizes, uint32_t alignment);
-            void PrepareOffsetSBO(uint8_t max_count, std::map<std::string, std::map<uint8_t, Maths::Matrix4x4*>>& prepared_ubo);
-            float EvalInterpolation(std::vector<KEYFRAME> const& keyframes, std::chrono::milliseconds const& time, KEYFRAME const& base = {});
+            // Forme compacte d'une courbe
+            enum CHANNEL_FLAGS : uint8_t {
+                CHANNEL_CONSTANT    = 0x01,     // Une seule KeyFrame, pas de liste de temps
+                CHANNEL_WIDE_TIME   = 0x02      // Temps absolus sur 32 bits au lieu d'carts sur 16 bits
+            };
+
+            static uint32_t ChannelSerializedSize(std::vector<KEYFRAME> const& keyframes);
+            static uint32_t SerializeChannel(std::vector<KEYFRAME> const& keyframes, char* output);
+            static uint32_t DeserializeChannel(std::vector<KEYFRAME>& keyframes, const char* data);
+            static uint32_t DeserializeLegacyChannel(std::vector<KEYFRAME>& keyframes, const char* data);
+
+            // Position de lecture des 9 courbes d'un bone, une par composante de translation, rotation et mise  l'chelle
+            typedef std::array<uint32_t, 9> KEYFRAME_CURSORS;
+
+            static void BuildOffsetsSBO(std::vector<char>& offsets, std::vector<char>& offsets_ids, std::map<std::string, std::map<uint8_t, Maths::Matrix4x4 const*>> const& prepared_bone_offsets_ubo,
+                                        std::map<std::string, std::pair<uint32_t, uint32_t>>& sub_segment_sizes, uint32_t alignment);
+            void PrepareOffsetSBO(uint8_t max_count, std::map<std::string, std::map<uint8_t, Maths::Matrix4x4 const*>>& prepared_ubo) const;
+            static float EvalInterpolation(std::vector<KEYFRAME> const& keyframes, std::chrono::milliseconds const& time, KEYFRAME const& base = {});
+            static float EvalInterpolation(std::vector<KEYFRAME> const& keyframes, std::chrono::milliseconds const& time, uint32_t& cursor, KEYFRAME const& base = {});
+            static float EvalInterpolation(KEYFRAME const* keyframes, uint32_t count, std::chrono::milliseconds const& time, uint32_t& cursor, KEYFRAME const& base = {});
+            static uint32_t FindKeyFrame(KEYFRAME const* keyframes, uint32_t count, std::chrono::milliseconds const& time, uint32_t& cursor);
     };
 }
\ No newline at end of file
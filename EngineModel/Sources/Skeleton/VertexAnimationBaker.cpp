@@ -0,0 +1,141 @@
+#include "VertexAnimationBaker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace Model
+{
+    VertexAnimationBaker::VertexAnimationBaker(FlatSkeleton const& skeleton, uint8_t frames_per_second) : row_count(0)
+    {
+        AnimationBaker baker(skeleton, frames_per_second);
+        this->animations = baker.GetAnimations();
+        this->bone_per_frame = baker.GetBonePerFrame();
+        this->palettes.resize(baker.GetOutputSize());
+        if(!this->palettes.empty()) baker.Bake(this->palettes.data());
+
+        for(auto const& animation : this->animations)
+            this->row_count += animation.baked_frames;
+
+        // The shaders only read the bone offsets of the first mesh, in name order
+        auto const& offsets = skeleton.GetOffsets();
+        auto const& mesh_names = skeleton.GetMeshNames();
+        uint32_t mesh = UINT32_MAX;
+        for(auto const& bone : skeleton.GetBones()) {
+            if(bone.index >= Bone::MAX_BONES_PER_UBO || !bone.offset_count) continue;
+            uint32_t bone_mesh = offsets[bone.first_offset].mesh;
+            if(mesh == UINT32_MAX || mesh_names[bone_mesh] < mesh_names[mesh]) mesh = bone_mesh;
+        }
+
+        this->bone_offsets.resize(this->bone_per_frame, IDENTITY_MATRIX);
+        for(auto const& bone : skeleton.GetBones()) {
+            if(bone.index >= this->bone_offsets.size()) continue;
+            for(uint32_t i=bone.first_offset; i<bone.first_offset + bone.offset_count; i++)
+                if(offsets[i].mesh == mesh) this->bone_offsets[bone.index] = offsets[i].matrix;
+        }
+    }
+
+    /**
+     * Decode a vertex of a cooked mesh
+     * @param mesh Cooked mesh
+     * @param vertex_id Index of the vertex in the whole vertex buffer
+     */
+    VertexAnimationBaker::SKINNED_VERTEX VertexAnimationBaker::ReadVertex(CookedMesh const& mesh, uint32_t vertex_id)
+    {
+        SKINNED_VERTEX vertex;
+        const char* data = mesh.GetVertexData() + vertex_id * CookedMesh::GetVertexStride(mesh.GetVertexFormat());
+
+        if(mesh.GetVertexFormat() == CookedMesh::COMPACT_VERTEX) {
+            std::array<uint16_t, 4> position;
+            std::array<uint8_t, Deformer::MAX_BONES_PER_VERTEX> weights;
+            std::array<uint8_t, Deformer::MAX_BONES_PER_VERTEX> bone_ids;
+            std::memcpy(position.data(), data, sizeof(position));
+            std::memcpy(weights.data(), data + 6 * sizeof(uint16_t), sizeof(weights));
+            std::memcpy(bone_ids.data(), data + 6 * sizeof(uint16_t) + sizeof(weights), sizeof(bone_ids));
+
+            CookedMesh::DEQUANTIZATION const& dequantization = mesh.GetDequantization();
+            for(uint8_t i=0; i<3; i++)
+                vertex.position[i] = static_cast<float>(position[i]) / UINT16_MAX * dequantization.position_scale[i] + dequantization.position_offset[i];
+            for(uint8_t i=0; i<Deformer::MAX_BONES_PER_VERTEX; i++) {
+                vertex.weights[i] = static_cast<float>(weights[i]) / UINT8_MAX;
+                vertex.bone_ids[i] = bone_ids[i];
+            }
+        }else{
+            std::memcpy(&vertex.position, data, sizeof(Maths::Vector3));
+            std::memcpy(vertex.weights.data(), data + sizeof(Maths::Vector3) + sizeof(Maths::Vector2), sizeof(vertex.weights));
+            std::memcpy(vertex.bone_ids.data(), data + sizeof(Maths::Vector3) + sizeof(Maths::Vector2) + sizeof(vertex.weights), sizeof(vertex.bone_ids));
+        }
+
+        return vertex;
+    }
+
+    bool VertexAnimationBaker::Bake(CookedMesh const& mesh, uint8_t level, TEXTURE& output, uint32_t thread_count) const
+    {
+        if(level >= mesh.lods.size() || !this->row_count || !this->bone_per_frame) return false;
+
+        CookedMesh::LOD_RANGE const& lod = mesh.lods[level];
+        std::vector<SKINNED_VERTEX> vertices(lod.vertex_count);
+        for(uint32_t i=0; i<lod.vertex_count; i++)
+            vertices[i] = VertexAnimationBaker::ReadVertex(mesh, lod.first_vertex + i);
+
+        output.vertex_count = lod.vertex_count;
+        output.row_count = this->row_count;
+        output.first_rows.clear();
+        for(auto const& animation : this->animations)
+            output.first_rows.push_back(static_cast<uint32_t>(animation.offset / (this->bone_per_frame * sizeof(Maths::Matrix4x4))));
+
+        // Same skinning as the vertex shaders, rows are shared between threads
+        std::vector<Maths::Vector3> positions(static_cast<size_t>(this->row_count) * lod.vertex_count);
+        auto skin_row = [&](uint32_t row) {
+            Maths::Matrix4x4 const* palette = reinterpret_cast<Maths::Matrix4x4 const*>(this->palettes.data()) + static_cast<size_t>(row) * this->bone_per_frame;
+            for(uint32_t i=0; i<lod.vertex_count; i++) {
+                SKINNED_VERTEX const& vertex = vertices[i];
+                Maths::Vector3 skinned = {};
+                float total_weight = 0.0f;
+                for(uint8_t j=0; j<Deformer::MAX_BONES_PER_VERTEX; j++) {
+                    if(vertex.weights[j] == 0.0f) break;
+                    if(vertex.bone_ids[j] >= this->bone_per_frame) continue;
+                    Maths::Vector3 transformed;
+                    transformed = (palette[vertex.bone_ids[j]] * this->bone_offsets[vertex.bone_ids[j]]) * vertex.position;
+                    skinned = skinned + transformed * vertex.weights[j];
+                    total_weight += vertex.weights[j];
+                }
+                positions[static_cast<size_t>(row) * lod.vertex_count + i] = total_weight > 0.0f ? skinned / total_weight : vertex.position;
+            }
+        };
+
+        if(!thread_count) thread_count = std::thread::hardware_concurrency();
+        thread_count = std::max<uint32_t>(std::min(thread_count, this->row_count), 1);
+
+        std::atomic<uint32_t> next_row(0);
+        auto work = [&]() { for(uint32_t row = next_row++; row < this->row_count; row = next_row++) skin_row(row); };
+        std::vector<std::thread> workers;
+        for(uint32_t i=1; i<thread_count; i++) workers.emplace_back(work);
+        work();
+        for(auto& worker : workers) worker.join();
+
+        // Quantize within the bounding box of every frame
+        Maths::Vector3 range_min = positions.empty() ? Maths::Vector3() : positions[0];
+        Maths::Vector3 range_max = range_min;
+        for(auto const& position : positions) {
+            for(uint8_t j=0; j<3; j++) {
+                range_min[j] = std::min(range_min[j], position[j]);
+                range_max[j] = std::max(range_max[j], position[j]);
+            }
+        }
+
+        output.position_offset = {range_min.x, range_min.y, range_min.z, 0.0f};
+        output.position_scale = {range_max.x - range_min.x, range_max.y - range_min.y, range_max.z - range_min.z, 0.0f};
+        output.texels.resize(positions.size());
+        for(size_t i=0; i<positions.size(); i++) {
+            TEXEL texel = {};
+            for(uint8_t j=0; j<3; j++) {
+                float normalized = output.position_scale[j] > 0.0f ? (positions[i][j] - range_min[j]) / output.position_scale[j] : 0.0f;
+                texel[j] = static_cast<uint16_t>(std::min(std::max(normalized, 0.0f), 1.0f) * UINT16_MAX + 0.5f);
+            }
+            output.texels[i] = texel;
+        }
+
+        return true;
+    }
+}
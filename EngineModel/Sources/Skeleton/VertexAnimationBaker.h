@@ -0,0 +1,70 @@
+#pragma once
+
+#include "AnimationBaker.h"
+#include "../CookedMesh/CookedMesh.h"
+
+namespace Model
+{
+    /**
+     * Bake the skinned positions of a LOD into a vertex animation texture.
+     * Each row holds one frame and each column one vertex of the LOD. Rows follow the frame layout of AnimationBaker,
+     * so the frame ids given to a unit address both its bone palette and its row.
+     * Positions are quantized to 16 bits within the bounding box of the LOD over every frame,
+     * a far unit then costs a single fetch per vertex instead of blending bone matrices.
+     */
+    class VertexAnimationBaker
+    {
+        public :
+
+            /// Quantized position : unorm16 x, y, z, the last component is unused
+            typedef std::array<uint16_t, 4> TEXEL;
+
+            /// Baked LOD
+            struct TEXTURE {
+                uint32_t vertex_count;                  // Texels per row
+                uint32_t row_count;                     // Baked frames of every animation
+                std::vector<uint32_t> first_rows;       // Row of the first frame of each animation
+                Maths::Vector4 position_offset;         // position = texel * scale + offset
+                Maths::Vector4 position_scale;
+                std::vector<TEXEL> texels;              // row_count * vertex_count texels
+            };
+
+            /**
+             * Bake the bone palettes of every animation, the skeleton is not referenced afterwards
+             * @param skeleton Flat skeleton
+             * @param frames_per_second Sampling rate of the animations, must match the one of the bone palettes
+             */
+            VertexAnimationBaker(FlatSkeleton const& skeleton, uint8_t frames_per_second = 30);
+
+            /// Animations in the same order as FlatSkeleton::GetAnimations
+            inline std::vector<AnimationBaker::BAKED_ANIMATION> const& GetAnimations() const { return this->animations; }
+
+            /**
+             * Skin every vertex of a LOD for every frame
+             * @param mesh Cooked mesh holding the LOD
+             * @param level LOD level
+             * @param output[out] Vertex animation texture of the LOD
+             * @param thread_count Number of threads, 0 to use one per hardware thread
+             * @retval true Success
+             * @retval false Unknown level or no animation
+             */
+            bool Bake(CookedMesh const& mesh, uint8_t level, TEXTURE& output, uint32_t thread_count = 0) const;
+
+        private :
+
+            /// Vertex of a LOD, as read by the vertex shaders
+            struct SKINNED_VERTEX {
+                Maths::Vector3 position;
+                std::array<float, Deformer::MAX_BONES_PER_VERTEX> weights;
+                std::array<uint32_t, Deformer::MAX_BONES_PER_VERTEX> bone_ids;
+            };
+
+            std::vector<AnimationBaker::BAKED_ANIMATION> animations;
+            std::vector<char> palettes;                 // Every baked frame
+            std::vector<Maths::Matrix4x4> bone_offsets; // Bone offset of each bone index, as seen by the shaders
+            uint32_t bone_per_frame;
+            uint32_t row_count;
+
+            static SKINNED_VERTEX ReadVertex(CookedMesh const& mesh, uint32_t vertex_id);
+    };
+}
@@ -0,0 +1,161 @@
+#include "VertexCache.h"
+
+#include <cmath>
+#include <algorithm>
+
+namespace Model
+{
+    float VertexCache::VertexScore(int32_t cache_position, uint32_t remaining_triangles)
+    {
+        // Vertex is not used anymore
+        if(!remaining_triangles) return -1.0f;
+
+        float score = 0.0f;
+        if(cache_position >= 0) {
+            // Vertices of the last triangle get a fixed score, so that strips are not favored over fans
+            if(cache_position < 3) score = 0.75f;
+            else score = std::pow(1.0f - static_cast<float>(cache_position - 3) / static_cast<float>(OPTIMIZATION_CACHE_SIZE - 3), 1.5f);
+        }
+
+        // Vertices with few remaining triangles are finished first
+        score += 2.0f / std::sqrt(static_cast<float>(remaining_triangles));
+        return score;
+    }
+
+    void VertexCache::OptimizeTriangles(std::vector<uint32_t>& indices, uint32_t vertex_count)
+    {
+        if(indices.size() < 6 || indices.size() % 3) return;
+        uint32_t triangle_count = static_cast<uint32_t>(indices.size() / 3);
+
+        // Triangles using each vertex, packed in a single array
+        std::vector<uint32_t> remaining(vertex_count, 0);
+        for(uint32_t index : indices) remaining[index]++;
+
+        std::vector<uint32_t> first_triangle(vertex_count + 1, 0);
+        for(uint32_t i=0; i<vertex_count; i++) first_triangle[i + 1] = first_triangle[i] + remaining[i];
+
+        std::vector<uint32_t> adjacency(indices.size());
+        std::vector<uint32_t> fill(first_triangle.begin(), first_triangle.end() - 1);
+        for(uint32_t i=0; i<indices.size(); i++) adjacency[fill[indices[i]]++] = i / 3;
+
+        // Initial scores
+        std::vector<int32_t> cache_position(vertex_count, -1);
+        std::vector<float> vertex_score(vertex_count);
+        for(uint32_t i=0; i<vertex_count; i++) vertex_score[i] = VertexCache::VertexScore(-1, remaining[i]);
+
+        std::vector<float> triangle_score(triangle_count);
+        std::vector<bool> added(triangle_count, false);
+        uint32_t best_triangle = 0;
+        for(uint32_t i=0; i<triangle_count; i++) {
+            triangle_score[i] = vertex_score[indices[i * 3]] + vertex_score[indices[i * 3 + 1]] + vertex_score[indices[i * 3 + 2]];
+            if(triangle_score[i] > triangle_score[best_triangle]) best_triangle = i;
+        }
+
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+        std::vector<uint32_t> cache, new_cache;
+        cache.reserve(OPTIMIZATION_CACHE_SIZE + 3);
+        new_cache.reserve(OPTIMIZATION_CACHE_SIZE + 3);
+        uint32_t scan_position = 0;
+
+        for(uint32_t i=0; i<triangle_count; i++) {
+
+            // No candidate in cache, continue with the next triangle in the original order
+            if(best_triangle == UINT32_MAX) {
+                while(added[scan_position]) scan_position++;
+                best_triangle = scan_position;
+            }
+
+            // Output triangle, its vertices go to the front of the cache
+            added[best_triangle] = true;
+            new_cache.clear();
+            for(uint8_t j=0; j<3; j++) {
+                uint32_t vertex = indices[best_triangle * 3 + j];
+                output.push_back(vertex);
+                if(std::find(new_cache.begin(), new_cache.end(), vertex) != new_cache.end()) continue;
+                new_cache.push_back(vertex);
+
+                uint32_t* triangles = adjacency.data() + first_triangle[vertex];
+                uint32_t* last = triangles + remaining[vertex];
+                uint32_t* found = std::find(triangles, last, best_triangle);
+                if(found != last) {
+                    std::swap(*found, *(last - 1));
+                    remaining[vertex]--;
+                }
+            }
+
+            for(uint32_t vertex : cache)
+                if(std::find(new_cache.begin(), new_cache.end(), vertex) == new_cache.end()) new_cache.push_back(vertex);
+
+            // Update vertex scores, including the ones pushed out of the cache
+            for(uint32_t j=0; j<new_cache.size(); j++) {
+                uint32_t vertex = new_cache[j];
+                cache_position[vertex] = j < OPTIMIZATION_CACHE_SIZE ? static_cast<int32_t>(j) : -1;
+                vertex_score[vertex] = VertexCache::VertexScore(cache_position[vertex], remaining[vertex]);
+            }
+
+            // Update triangle scores and find the best candidate among triangles using cached vertices
+            best_triangle = UINT32_MAX;
+            float best_score = -1.0f;
+            for(uint32_t vertex : new_cache) {
+                for(uint32_t j=0; j<remaining[vertex]; j++) {
+                    uint32_t triangle = adjacency[first_triangle[vertex] + j];
+                    triangle_score[triangle] = vertex_score[indices[triangle * 3]]
+                                             + vertex_score[indices[triangle * 3 + 1]]
+                                             + vertex_score[indices[triangle * 3 + 2]];
+
+                    if(cache_position[vertex] >= 0 && triangle_score[triangle] > best_score) {
+                        best_score = triangle_score[triangle];
+                        best_triangle = triangle;
+                    }
+                }
+            }
+
+            if(new_cache.size() > OPTIMIZATION_CACHE_SIZE) new_cache.resize(OPTIMIZATION_CACHE_SIZE);
+            std::swap(cache, new_cache);
+        }
+
+        indices = std::move(output);
+    }
+
+    std::vector<uint32_t> VertexCache::OptimizeFetch(std::vector<uint32_t>& indices, uint32_t vertex_count)
+    {
+        std::vector<uint32_t> new_index(vertex_count, UINT32_MAX);
+        std::vector<uint32_t> old_index;
+        old_index.reserve(vertex_count);
+
+        for(uint32_t& index : indices) {
+            if(new_index[index] == UINT32_MAX) {
+                new_index[index] = static_cast<uint32_t>(old_index.size());
+                old_index.push_back(index);
+            }
+            index = new_index[index];
+        }
+
+        // Unused vertices are kept at the end
+        for(uint32_t i=0; i<vertex_count; i++)
+            if(new_index[i] == UINT32_MAX) old_index.push_back(i);
+
+        return old_index;
+    }
+
+    VertexCache::STATS VertexCache::Analyze(std::vector<uint32_t> const& indices, uint32_t vertex_count, uint32_t cache_size)
+    {
+        STATS stats = {};
+        if(indices.empty() || !vertex_count) return stats;
+
+        // A vertex is still cached if less than cache_size misses happened since it was loaded
+        std::vector<uint32_t> loaded_at(vertex_count, 0);
+        uint32_t misses = 0;
+        for(uint32_t index : indices) {
+            if(loaded_at[index] == 0 || misses - loaded_at[index] >= cache_size) {
+                misses++;
+                loaded_at[index] = misses;
+            }
+        }
+
+        stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+        stats.atvr = static_cast<float>(misses) / static_cast<float>(vertex_count);
+        return stats;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace Model
+{
+    /**
+     * Offline reordering of triangle lists for the GPU post-transform cache.
+     * Triangles are sorted with Tom Forsyth's linear-speed vertex cache optimisation,
+     * then vertices are renumbered in first use order so that vertex fetch becomes sequential.
+     */
+    class VertexCache
+    {
+        public :
+
+            /// Cache size assumed by the triangle reordering
+            static const uint32_t OPTIMIZATION_CACHE_SIZE = 32;
+
+            /// FIFO cache size used to measure the result, close to common hardware
+            static const uint32_t SIMULATION_CACHE_SIZE = 16;
+
+            /// Post-transform cache efficiency of an index buffer
+            struct STATS {
+                float acmr;     ///< Average cache miss ratio : transformed vertices per triangle, 0.5 is ideal, 3 is worst
+                float atvr;     ///< Average transformed vertex ratio : transformed vertices per vertex, 1 is ideal
+            };
+
+            /**
+             * Reorder triangles to maximize post-transform cache hits
+             * @param indices Triangle list, rewritten in place
+             * @param vertex_count Number of vertices referenced by indices
+             */
+            static void OptimizeTriangles(std::vector<uint32_t>& indices, uint32_t vertex_count);
+
+            /**
+             * Renumber vertices in the order they are first used by the index buffer
+             * @param indices Triangle list, rewritten with new vertex numbers
+             * @param vertex_count Number of vertices referenced by indices
+             * @return For every new vertex number, the old one
+             */
+            static std::vector<uint32_t> OptimizeFetch(std::vector<uint32_t>& indices, uint32_t vertex_count);
+
+            /**
+             * Simulate a FIFO post-transform cache
+             * @param indices Triangle list
+             * @param vertex_count Number of vertices referenced by indices
+             * @param cache_size Simulated cache size
+             * @return Cache efficiency
+             */
+            static STATS Analyze(std::vector<uint32_t> const& indices, uint32_t vertex_count, uint32_t cache_size = SIMULATION_CACHE_SIZE);
+
+        private :
+
+            VertexCache(){}
+
+            /**
+             * Forsyth vertex score
+             * @param cache_position Position in the simulated LRU cache, -1 when out of cache
+             * @param remaining_triangles Triangles using this vertex that are not output yet
+             */
+            static float VertexScore(int32_t cache_position, uint32_t remaining_triangles);
+    };
+}
\ No newline at end of file
@@ -1,16 +1,41 @@
 #version 450
 
-#define MAX_BONE_PER_VERTEX		4
+// Bones read per vertex, specialized by the renderer from the influences of the mesh
+layout (constant_id = 0) const int MAX_BONE_PER_VERTEX = 4;
 
+// Compiled twice, COMPACT_VERTEX reads the quantized vertices of CookedMesh::COMPACT_VERTEX
+#ifdef COMPACT_VERTEX
+layout (location = 0)  in vec4  inPos;
+layout (location = 1)  in vec2  inUV;
+layout (location = 2)  in vec4  inBoneWeights;
+layout (location = 3)  in uvec4 inBoneIDs;
+#else
 layout (location = 0)  in vec3  inPos;
 layout (location = 1)  in vec2  inUV;
 layout (location = 2)  in vec4  inBoneWeights;
 layout (location = 3)  in ivec4 inBoneIDs;
+#endif
 
 layout (location = 4)  in mat4 model;
 
 layout (location = 8)  in uint animation_id;
 layout (location = 9)  in uint frame_id;
+layout (location = 10) in uint previous_animation_id;
+layout (location = 11) in uint previous_frame_id;
+layout (location = 12) in float blend_weight;
+layout (location = 13) in uint vertex_animation;
+
+layout (push_constant) uniform Draw
+{
+#ifdef COMPACT_VERTEX
+	vec4 position_offset;
+	vec4 position_scale;
+	vec4 uv_transform;
+	uint skeleton_id;
+#else
+	layout (offset = 48) uint skeleton_id;
+#endif
+} draw;
 
 layout (set=1, binding=0) uniform Camera
 {
@@ -35,9 +60,65 @@ layout (set=2, binding=2) buffer Offsets
 
 layout (set=2, binding=3) buffer Animations
 {
-	uint bone_count;
 	uint first_frame_id[];
-} animations;
+};
+
+layout (set=2, binding=4, std430) buffer Palette
+{
+	uint count;
+	uint capacity;
+	uint matrix_count;
+	uint matrix_capacity;
+	uint first_matrix;
+	uint padding[3];
+	uint entity_slots[];
+} palette;
+
+struct SKELETON
+{
+	uint mode;
+	uint bone_count;
+	uint first_animation;
+	uint first_offset_id;
+	uint fallback_palette;
+	uint first_node;
+	uint node_count;
+	uint first_track;
+	uint first_key;
+	uint animation_count;
+	float frame_duration;
+	uint padding;
+};
+
+layout (set=2, binding=6, std430) buffer Registry
+{
+	SKELETON skeletons[];
+};
+
+struct VERTEX_ANIMATION
+{
+	uint first_animation;
+	uint first_vertex;
+	uint vertex_count;
+	uint padding;
+	vec4 position_offset;
+	vec4 position_scale;
+};
+
+layout (set=3, binding=0, std430) readonly buffer VertexAnimations
+{
+	VERTEX_ANIMATION vertex_animations[];
+};
+
+layout (set=3, binding=1, std430) readonly buffer VertexAnimationRows
+{
+	uint first_rows[];
+};
+
+layout (set=3, binding=2, std430) readonly buffer VertexAnimationTexels
+{
+	uvec2 texels[];
+};
 
 layout (location = 0) out vec2 outUV;
 
@@ -50,29 +131,67 @@ vec3 MatrixMultT(mat4 matrix, vec3 vertex)
 	);
 }
 
+// Skinned position baked for a frame, one row per frame and one texel per vertex of the LOD
+vec3 BakedPosition(VERTEX_ANIMATION baked, uint animation, uint frame)
+{
+	uvec2 texel = texels[first_rows[baked.first_animation + animation] + frame * baked.vertex_count + uint(gl_VertexIndex) - baked.first_vertex];
+	return vec3(unpackUnorm2x16(texel.x), unpackUnorm2x16(texel.y).x) * baked.position_scale.xyz + baked.position_offset.xyz;
+}
+
 void main() 
 {
+	// Rigid meshes have no skeleton, every unit type indexes its own entry of the registry
+	bool skinned = draw.skeleton_id != 0xFFFFFFFF;
+	SKELETON rig = skeletons[skinned ? draw.skeleton_id : 0];
+
+	// Runtime palettes are located by the culling pass, crossfades are already applied
+	bool runtime_palette = rig.mode > 0;
+	// Palette offsets are counted in matrices
+	uint palette_offset = runtime_palette ? palette.entity_slots[gl_InstanceIndex]
+										  : first_frame_id[rig.first_animation + animation_id] + rig.bone_count * frame_id;
+	uint previous_palette_offset = first_frame_id[rig.first_animation + previous_animation_id] + rig.bone_count * previous_frame_id;
+	bool crossfade = !runtime_palette && blend_weight < 1.0;
 	mat4 boneTransform = mat4(0);
 	mat4 modelView = camera.view * model;
 	bool has_bone = false;
 	float total_weight = 0.0f;
 
+#ifdef COMPACT_VERTEX
+	vec3 position = inPos.xyz * draw.position_scale.xyz + draw.position_offset.xyz;
+	outUV = inUV * draw.uv_transform.zw + draw.uv_transform.xy;
+#else
+	vec3 position = inPos;
 	outUV = inUV;
+#endif
+
+	// Far LODs skip skinning, crossfades blend the baked positions
+	if(vertex_animation != 0xFFFFFFFF) {
+		VERTEX_ANIMATION baked = vertex_animations[vertex_animation];
+		vec3 baked_position = BakedPosition(baked, animation_id, frame_id);
+		if(blend_weight < 1.0) baked_position = mix(BakedPosition(baked, previous_animation_id, previous_frame_id), baked_position, blend_weight);
+		gl_Position = camera.projection * modelView * vec4(baked_position, 1.0);
+		return;
+	}
 
 	for(int i=0; i<MAX_BONE_PER_VERTEX; i++) {
-		if(inBoneWeights[i] == 0) break;
-		boneTransform += skeleton.bones[animations.bone_count * frame_id + inBoneIDs[i]] * offsets[offset_ids[inBoneIDs[i]]] * inBoneWeights[i];
+		if(!skinned || inBoneWeights[i] == 0) break;
+		mat4 bone = skeleton.bones[palette_offset + inBoneIDs[i]];
+		if(crossfade) {
+			mat4 previous_bone = skeleton.bones[previous_palette_offset + inBoneIDs[i]];
+			bone = previous_bone + (bone - previous_bone) * blend_weight;
+		}
+		boneTransform += bone * offsets[offset_ids[rig.first_offset_id + inBoneIDs[i]]] * inBoneWeights[i];
 		total_weight += inBoneWeights[i];
 		has_bone = true;
 	}
 	
 	if(!has_bone) {
 	
-		gl_Position = camera.projection * modelView * vec4(inPos, 1.0);
+		gl_Position = camera.projection * modelView * vec4(position, 1.0);
 		
 	}else{
 	
-		vec3 transformed_vertex = MatrixMultT(boneTransform, inPos) / total_weight;
+		vec3 transformed_vertex = MatrixMultT(boneTransform, position) / total_weight;
 		gl_Position = camera.projection * modelView * vec4(transformed_vertex, 1.0);
 		
 	}
@@ -5,6 +5,7 @@ namespace Engine
     ComputeShader::ComputeShader()
     {
         this->command_pool = nullptr;
+        this->wait_previous_dispatch = false;
     }
 
     void ComputeShader::Clear()
@@ -18,8 +19,9 @@ namespace Engine
         this->count.clear();
     }
 
-    bool ComputeShader::Load(std::string path, std::vector<VkDescriptorSetLayout> descriptor_set_layouts)
+    bool ComputeShader::Load(std::string path, std::vector<VkDescriptorSetLayout> descriptor_set_layouts, bool wait_previous_dispatch)
     {
+        this->wait_previous_dispatch = wait_previous_dispatch;
         this->refresh.resize(Vulkan::GetSwapChainImageCount(), true);
         this->command_buffers.resize(Vulkan::GetSwapChainImageCount());
         this->count.resize(Vulkan::GetSwapChainImageCount());
@@ -76,6 +78,18 @@ namespace Engine
             return nullptr;
         }
 
+        // Storage buffers written by the previous dispatches of the queue are read by this one
+        if(this->wait_previous_dispatch) {
+            VkMemoryBarrier memory_barrier = {};
+            memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            memory_barrier.pNext = nullptr;
+            memory_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            memory_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+            vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                 0, 1, &memory_barrier, 0, nullptr, 0, nullptr);
+        }
+
         vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipeline.handle);
 
         vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, this->pipeline.layout, 0,
@@ -12,7 +12,7 @@ namespace Engine
             ComputeShader();
             ~ComputeShader() { this->Clear(); };
             void Clear();
-            bool Load(std::string path, std::vector<VkDescriptorSetLayout> descriptor_set_layouts);
+            bool Load(std::string path, std::vector<VkDescriptorSetLayout> descriptor_set_layouts, bool wait_previous_dispatch = false);
             VkCommandBuffer BuildCommandBuffer(uint8_t frame_index, std::vector<VkDescriptorSet> descriptor_sets, std::array<uint32_t, 3> count);
             void Refresh(uint8_t frame_index) { this->refresh[frame_index] = true; }
             void Refresh() { std::fill(this->refresh.begin(), this->refresh.end(), true); }
@@ -25,5 +25,6 @@ namespace Engine
             std::vector<VkCommandBuffer> command_buffers;
             vk::PIPELINE pipeline;
             std::vector<std::array<uint32_t, 3>> count;
+            bool wait_previous_dispatch;
     };
 }
\ No newline at end of file
@@ -15,6 +15,7 @@ namespace Engine
         this->collision_shader.Clear();
         this->movement_shader.Clear();
         this->cull_lod_shader.Clear();
+        this->palette_shader.Clear();
 
         // Movement Controller
         MovementController::GetInstance()->DestroyInstance();
@@ -75,6 +76,7 @@ namespace Engine
         GlobalData::CreateInstance();
         GlobalData::GetInstance()->dynamic_entity_descriptor.AddListener(this);
         GlobalData::GetInstance()->group_descriptor.AddListener(this);
+        GlobalData::GetInstance()->animation_tracks_descriptor.AddListener(this);
 
         Camera::CreateInstance();
         DynamicEntityRenderer::CreateInstance();
@@ -93,9 +95,19 @@ namespace Engine
             GlobalData::GetInstance()->dynamic_entity_descriptor.GetLayout(),
             GlobalData::GetInstance()->indirect_descriptor.GetLayout(),
             GlobalData::GetInstance()->lod_descriptor.GetLayout(),
-            GlobalData::GetInstance()->time_descriptor.GetLayout()
+            GlobalData::GetInstance()->time_descriptor.GetLayout(),
+            GlobalData::GetInstance()->skeleton_descriptor.GetLayout(),
+            GlobalData::GetInstance()->animation_event_descriptor.GetLayout()
         })) return false;
 
+        // Reads the palette slots given by the culling pass
+        if(!this->palette_shader.Load("./Shaders/animate_palette.comp.spv", {
+            GlobalData::GetInstance()->dynamic_entity_descriptor.GetLayout(),
+            GlobalData::GetInstance()->time_descriptor.GetLayout(),
+            GlobalData::GetInstance()->skeleton_descriptor.GetLayout(),
+            GlobalData::GetInstance()->animation_tracks_descriptor.GetLayout()
+        }, true)) return false;
+
         if(!this->movement_shader.Load("./Shaders/move_groups.comp.spv", {
             GlobalData::GetInstance()->dynamic_entity_descriptor.GetLayout(),
             GlobalData::GetInstance()->group_descriptor.GetLayout(),
@@ -115,6 +127,8 @@ namespace Engine
         vkDeviceWaitIdle(Vulkan::GetDevice());
         descriptor->Update(binding);
 
+        if(descriptor == &GlobalData::GetInstance()->animation_tracks_descriptor) this->palette_shader.Refresh();
+
         /*if(descriptor == &GlobalData::GetInstance()->dynamic_entity_descriptor && binding == ENTITY_MOVEMENT_BINDING) {
             this->movement_shader.Refresh();
             this->collision_shader.Refresh();
@@ -126,8 +140,35 @@ namespace Engine
         return DynamicEntityRenderer::GetInstance()->AddToScene(entity);
     }
 
-    bool Core::LoadSkeleton(Model::Bone skeleton)
+    bool Core::LoadSkeleton(std::shared_ptr<Model::FlatSkeleton> skeleton, GlobalData::SKINNING_MODE mode)
     {
+        if(skeleton == nullptr) return false;
+
+        // Every LOD group referencing the skeleton shares the data already uploaded
+        if(GlobalData::GetInstance()->skeletons.count(skeleton->GetName())) return true;
+
+        InstancedDescriptorSet& descriptor = GlobalData::GetInstance()->skeleton_descriptor;
+
+        // Each skeleton gets its own sub-range of the bindings, values written by the shaders are absolute
+        auto reserve = [&descriptor](size_t size, uint8_t binding) -> std::shared_ptr<Chunk> {
+            auto chunk = descriptor.ReserveRange(size, binding);
+            #if defined(DISPLAY_LOGS)
+            if(chunk == nullptr) std::cout << "Core::LoadSkeleton() : Not enough memory in binding " << static_cast<uint32_t>(binding) << std::endl;
+            #endif
+            return chunk;
+        };
+
+        auto registry_chunk = reserve(sizeof(GlobalData::SKELETON), SKELETON_REGISTRY_BINDING);
+        if(registry_chunk == nullptr) return false;
+
+        GlobalData::REGISTERED_SKELETON registered;
+        registered.id = static_cast<uint32_t>(registry_chunk->offset / sizeof(GlobalData::SKELETON));
+        registered.mode = mode;
+
+        GlobalData::SKELETON entry = {};
+        entry.mode = mode;
+        entry.fallback_palette = UINT32_MAX;
+
         /////////////////////////
         //   Mesh offsets SBO  //
         // Mesh offets ids SBO //
@@ -144,11 +185,30 @@ namespace Engine
         // Build buffers
         std::map<std::string, std::pair<uint32_t, uint32_t>> dynamic_offsets;
         uint32_t sbo_alignment = static_cast<uint32_t>(Vulkan::GetDeviceLimits().minStorageBufferOffsetAlignment);
-        skeleton.BuildBoneOffsetsSBO(offsets_sbo, offsets_ids, dynamic_offsets, sbo_alignment);
+        skeleton->BuildBoneOffsetsSBO(offsets_sbo, offsets_ids, dynamic_offsets, sbo_alignment);
+
+        if(!offsets_sbo.empty()) {
+            auto offsets_chunk = reserve((offsets_sbo.size() + sizeof(Maths::Matrix4x4) - 1) / sizeof(Maths::Matrix4x4) * sizeof(Maths::Matrix4x4), SKELETON_OFFSETS_BINDING);
+            auto ids_chunk = reserve(offsets_ids.size(), SKELETON_OFFSET_IDS_BINDING);
+            if(offsets_chunk == nullptr || ids_chunk == nullptr) return false;
+
+            // Offset ids of each mesh point into its own segment of the offsets
+            std::map<uint32_t, uint32_t> segments;
+            for(auto const& mesh : dynamic_offsets)
+                segments[mesh.second.second] = static_cast<uint32_t>((offsets_chunk->offset + mesh.second.first) / sizeof(Maths::Matrix4x4));
+
+            for(auto segment = segments.begin(); segment != segments.end(); segment++) {
+                auto next = std::next(segment);
+                size_t end = next != segments.end() ? next->first : offsets_ids.size();
+                for(size_t offset = segment->first; offset < end; offset += sizeof(uint32_t))
+                    *reinterpret_cast<uint32_t*>(offsets_ids.data() + offset) += segment->second;
+            }
 
-        // Write to GPU memory
-        GlobalData::GetInstance()->skeleton_descriptor.WriteData(offsets_sbo.data(), offsets_sbo.size(), 0, SKELETON_OFFSETS_BINDING);
-        GlobalData::GetInstance()->skeleton_descriptor.WriteData(offsets_ids.data(), offsets_ids.size(), 0, SKELETON_OFFSET_IDS_BINDING);
+            // Write to GPU memory
+            descriptor.WriteData(offsets_sbo.data(), offsets_sbo.size(), offsets_chunk->offset, SKELETON_OFFSETS_BINDING);
+            descriptor.WriteData(offsets_ids.data(), offsets_ids.size(), ids_chunk->offset, SKELETON_OFFSET_IDS_BINDING);
+            entry.first_offset_id = static_cast<uint32_t>(ids_chunk->offset / sizeof(uint32_t));
+        }
 
         ////////////////////
         // Animations SBO //
@@ -158,35 +218,127 @@ namespace Engine
         std::cout << "EntityRender::LoadSkeleton() : BuildAnimationSBO" << std::endl;
         #endif
 
-        auto const animations = skeleton.ListAnimations();
-        uint32_t animation_offset = 0;
-        uint32_t frame_id = 0;
+        if(mode == GlobalData::SKINNING_MODE::RUNTIME_PALETTE) {
+
+            // Compressed tracks are uploaded once, palettes are sampled each frame for visible units
+            Model::AnimationTracks tracks(*skeleton, 30);
+            entry.bone_count = tracks.GetBonePerFrame();
+            entry.node_count = tracks.GetNodeCount();
+            entry.frame_duration = tracks.GetFrameDuration();
+
+            auto const& animations = tracks.GetAnimations();
+            entry.animation_count = static_cast<uint32_t>(animations.size());
+            for(uint8_t i=0; i<animations.size(); i++) {
+                GlobalData::BAKED_ANIMATION baked_animation;
+                baked_animation.animation_id = i;
+                baked_animation.duration = animations[i].duration;
+                baked_animation.frame_count = animations[i].frame_count;
+                registered.animations[animations[i].name] = baked_animation;
+            }
 
-        for(uint8_t i=0; i<animations.size(); i++) {
+            // Tracks of every skeleton follow each other, first element of the new range is returned
+            auto write_tracks = [](const void* data, size_t size, size_t element_size, uint8_t binding, uint32_t& first) {
+                first = 0;
+                if(!size) return true;
+                MappedDescriptorSet& tracks_descriptor = GlobalData::GetInstance()->animation_tracks_descriptor;
+                auto chunk = tracks_descriptor.ReserveRange(size, binding);
+                if(chunk == nullptr) return false;
+                tracks_descriptor.WriteData(data, size, chunk->offset, binding);
+                first = static_cast<uint32_t>(chunk->offset / element_size);
+                return true;
+            };
 
-            GlobalData::BAKED_ANIMATION baked_animation;
-            baked_animation.animation_id = i;
-            baked_animation.duration = skeleton.GetAnimationTotalDuration(animations[i].name);
+            uint32_t first_key_value;
+            if(!write_tracks(tracks.GetNodes().data(), tracks.GetNodes().size() * sizeof(Model::AnimationTracks::NODE), sizeof(Model::AnimationTracks::NODE), ANIMATION_NODES_BINDING, entry.first_node)
+            || !write_tracks(tracks.GetTracks().data(), tracks.GetTracks().size() * sizeof(Model::AnimationTracks::NODE_TRACKS), sizeof(Model::AnimationTracks::NODE_TRACKS), ANIMATION_TRACKS_BINDING, entry.first_track)
+            || !write_tracks(tracks.GetKeyTimes().data(), tracks.GetKeyTimes().size() * sizeof(uint32_t), sizeof(uint32_t), ANIMATION_KEY_TIMES_BINDING, entry.first_key)
+            || !write_tracks(tracks.GetKeyValues().data(), tracks.GetKeyValues().size() * sizeof(Model::AnimationTracks::KEY_VALUE), sizeof(Model::AnimationTracks::KEY_VALUE), ANIMATION_KEY_VALUES_BINDING, first_key_value)) {
+                #if defined(DISPLAY_LOGS)
+                std::cout << "Core::LoadSkeleton() : Not enough memory for animation tracks" << std::endl;
+                #endif
+                return false;
+            }
 
-            // Build buffer
-            std::vector<char> skeleton_sbo;
-            uint32_t bone_count;
-            skeleton.BuildAnimationSBO(skeleton_sbo, animations[i].name, baked_animation.frame_count, bone_count, 30);
-            
-            // Write the bone count before frame offsets
-            if(!i) GlobalData::GetInstance()->skeleton_descriptor.WriteData(&bone_count, sizeof(uint32_t), 0, SKELETON_ANIMATIONS_BINDING);
+            // Key times and values share the same indices
+            if(first_key_value != entry.first_key) {
+                #if defined(DISPLAY_LOGS)
+                std::cout << "Core::LoadSkeleton() : Animation key times and values are misaligned" << std::endl;
+                #endif
+                return false;
+            }
+
+            // Palettes of every runtime skeleton are handed out from the same range
+            if(!this->palette_chunk) {
+                this->palette_chunk = reserve(SKINNING_PALETTE_MATRIX_CAPACITY * sizeof(Maths::Matrix4x4), SKELETON_BONES_BINDING);
+                if(this->palette_chunk == nullptr) return false;
+
+                GlobalData::PALETTE_HEADER palette_header = {};
+                palette_header.capacity = SKINNING_PALETTE_CAPACITY;
+                palette_header.matrix_capacity = SKINNING_PALETTE_MATRIX_CAPACITY;
+                palette_header.first_matrix = static_cast<uint32_t>(this->palette_chunk->offset / sizeof(Maths::Matrix4x4));
+                descriptor.WriteData(&palette_header, sizeof(GlobalData::PALETTE_HEADER), 0, SKELETON_PALETTE_BINDING);
+            }
+
+            // Units beyond the capacity hold the first pose of the first animation
+            if(entry.bone_count > 0) {
+                auto fallback_chunk = reserve(entry.bone_count * sizeof(Maths::Matrix4x4), SKELETON_BONES_BINDING);
+                if(fallback_chunk == nullptr) return false;
+
+                Model::AnimationBaker baker(*skeleton, 30);
+                std::vector<char> fallback(baker.GetAnimations().empty() ? 0 : baker.GetAnimations()[0].size);
+                if(!fallback.empty()) baker.Bake(0, fallback.data());
+                fallback.resize(fallback_chunk->range);
+                descriptor.WriteData(fallback.data(), fallback.size(), fallback_chunk->offset, SKELETON_BONES_BINDING);
+                entry.fallback_palette = static_cast<uint32_t>(fallback_chunk->offset / sizeof(Maths::Matrix4x4));
+            }
+
+            #if defined(DISPLAY_LOGS)
+            std::cout << "Core::LoadSkeleton() : Animation tracks " << tracks.GetSize() << " bytes" << std::endl;
+            #endif
 
-            // Write the frame offset
-            GlobalData::GetInstance()->skeleton_descriptor.WriteData(&frame_id, sizeof(uint32_t), sizeof(uint32_t) * (i + 1), SKELETON_ANIMATIONS_BINDING);
+            GlobalData::GetInstance()->runtime_node_count = std::max(GlobalData::GetInstance()->runtime_node_count, entry.node_count);
+            this->palette_shader.Refresh();
 
-            // Write animation to GPU memory
-            GlobalData::GetInstance()->skeleton_descriptor.WriteData(skeleton_sbo.data(), skeleton_sbo.size(), animation_offset, SKELETON_BONES_BINDING);
+        }else{
 
-            frame_id += static_cast<uint32_t>(skeleton_sbo.size() / sizeof(Maths::Matrix4x4));
-            animation_offset += static_cast<uint32_t>((static_cast<uint32_t>(skeleton_sbo.size()) + sbo_alignment - 1) & ~(sbo_alignment - 1));
-            GlobalData::GetInstance()->animations[animations[i].name] = baked_animation;
+            // Bake every animation in a single buffer, frames are evaluated in parallel
+            Model::AnimationBaker baker(*skeleton, 30);
+            std::vector<char> skeleton_sbo(baker.GetOutputSize());
+            baker.Bake(skeleton_sbo.data());
+            entry.bone_count = baker.GetBonePerFrame();
+
+            auto const& animations = baker.GetAnimations();
+            entry.animation_count = static_cast<uint32_t>(animations.size());
+            if(!animations.empty()) {
+                auto bones_chunk = reserve(skeleton_sbo.size(), SKELETON_BONES_BINDING);
+                auto frames_chunk = reserve(animations.size() * sizeof(uint32_t), SKELETON_ANIMATIONS_BINDING);
+                if(bones_chunk == nullptr || frames_chunk == nullptr) return false;
+
+                std::vector<uint32_t> frame_ids(animations.size());
+                for(uint8_t i=0; i<animations.size(); i++) {
+
+                    // Frame offset, in matrices from the start of the bones binding
+                    frame_ids[i] = static_cast<uint32_t>((bones_chunk->offset + animations[i].offset) / sizeof(Maths::Matrix4x4));
+
+                    GlobalData::BAKED_ANIMATION baked_animation;
+                    baked_animation.animation_id = i;
+                    baked_animation.duration = animations[i].duration;
+                    baked_animation.frame_count = animations[i].frame_count;
+                    registered.animations[animations[i].name] = baked_animation;
+                }
+
+                // Write to GPU memory
+                descriptor.WriteData(frame_ids.data(), frame_ids.size() * sizeof(uint32_t), frames_chunk->offset, SKELETON_ANIMATIONS_BINDING);
+                descriptor.WriteData(skeleton_sbo.data(), skeleton_sbo.size(), bones_chunk->offset, SKELETON_BONES_BINDING);
+                entry.first_animation = static_cast<uint32_t>(frames_chunk->offset / sizeof(uint32_t));
+            }
         }
 
+        descriptor.WriteData(&entry, sizeof(GlobalData::SKELETON), registry_chunk->offset, SKELETON_REGISTRY_BINDING);
+        std::string name = skeleton->GetName();
+        registered.skeleton = std::move(skeleton);
+        GlobalData::GetInstance()->skeletons[name] = std::move(registered);
+
         // Success
         return true;
     }
@@ -199,10 +351,56 @@ namespace Engine
         int32_t texture_id = GlobalData::GetInstance()->texture_descriptor.GetTextureID(texture);
         if(texture_id < 0) return false;
 
+        // Rigged meshes are drawn with the registered skeleton of the same name
+        std::string skeleton = lod.GetSkeleton();
+        if(!skeleton.empty()) {
+            auto registered = GlobalData::GetInstance()->skeletons.find(skeleton);
+            if(registered == GlobalData::GetInstance()->skeletons.end()) {
+                #if defined(DISPLAY_LOGS)
+                std::cout << "Core::LoadModel() : Skeleton " << skeleton << " must be loaded first" << std::endl;
+                #endif
+                return false;
+            }
+            lod.SetSkeletonID(registered->second.id);
+        }
+
         lod.SetTextureID(texture_id);
         return lod.Build();
     }
 
+    /**
+     * Report the play once clips finished during the last use of this frame's resources
+     * @param frame_index Frame whose fence has been waited
+     */
+    void Core::DispatchAnimationEvents(uint32_t frame_index)
+    {
+        InstancedDescriptorSet& descriptor = GlobalData::GetInstance()->animation_event_descriptor;
+        GlobalData::GetInstance()->instanced_buffer.Invalidate(frame_index);
+
+        GlobalData::ANIMATION_EVENT_HEADER header;
+        descriptor.ReadData(&header, sizeof(GlobalData::ANIMATION_EVENT_HEADER), 0, 0, frame_index);
+        if(!header.count) return;
+
+        uint32_t count = std::min<uint32_t>(header.count, ANIMATION_EVENT_CAPACITY);
+        std::vector<GlobalData::ANIMATION_EVENT> events(count);
+        descriptor.ReadData(events.data(), count * sizeof(GlobalData::ANIMATION_EVENT), sizeof(GlobalData::ANIMATION_EVENT_HEADER), 0, frame_index);
+
+        #if defined(DISPLAY_LOGS)
+        if(header.count > count) std::cout << "Core::DispatchAnimationEvents() : " << header.count - count << " events lost" << std::endl;
+        #endif
+
+        // The culling pass appends from zero again
+        uint32_t event_count = 0;
+        descriptor.WriteData(&event_count, sizeof(uint32_t), 0, 0, frame_index);
+
+        // Events are read a frame late, the entity may have been destroyed and its slot handed out again
+        for(auto const& event : events) {
+            if(!GlobalData::GetInstance()->dynamic_entity_slots.IsUsed({event.entity_id, event.generation})) continue;
+            for(auto listener : this->Listeners)
+                listener->AnimationFinished(event.entity_id, event.animation_id);
+        }
+    }
+
     bool Core::BuildRenderPass(uint32_t frame_index)
     {
         VkCommandBuffer command_buffer = this->resources[frame_index].command_buffer;
@@ -300,14 +498,15 @@ namespace Engine
         Maths::Plane top_plane = {top_left_position, top_left_ray.Cross(-Camera::GetInstance()->GetRightVector())};
         Maths::Plane bottom_plane = {bottom_right_position, bottom_right_ray.Cross(Camera::GetInstance()->GetRightVector())};
 
+        // Hit-boxes of every entity are tested at once
+        std::vector<DynamicEntity*> const& all_entities = DynamicEntityRenderer::GetInstance()->GetEntities();
+        std::vector<uint8_t> inside;
+        DynamicEntity::InSelectBox(all_entities, {left_plane, right_plane, top_plane, bottom_plane}, inside);
+
         std::vector<DynamicEntity*> entities;
-        for(auto entity : DynamicEntityRenderer::GetInstance()->GetEntities()) {
-            if(entity->InSelectBox(left_plane, right_plane, top_plane, bottom_plane)) {
-                entity->selected = true;
-                entities.push_back(entity);
-            }else{
-                entity->selected = false;
-            }
+        for(size_t i=0; i<all_entities.size(); i++) {
+            all_entities[i]->selected = inside[i] != 0;
+            if(inside[i]) entities.push_back(all_entities[i]);
         }
 
         uint32_t count = static_cast<uint32_t>(entities.size());
@@ -350,27 +549,21 @@ namespace Engine
         Maths::Vector3 mouse_ray = mouse_world_position - camera_position;
         mouse_ray = mouse_ray.Normalize();
 
-        DynamicEntity* selected_entity = nullptr;
-        for(auto entity : DynamicEntityRenderer::GetInstance()->GetEntities()) {
-            if(selected_entity != nullptr) {
-                entity->selected = false;
-            }else if(entity->IntersectRay(camera_position, mouse_ray)) {
+        // First entity hit by the ray, hit-boxes of every entity are tested at once
+        std::vector<DynamicEntity*> const& entities = DynamicEntityRenderer::GetInstance()->GetEntities();
+        uint32_t selected_entity = DynamicEntity::IntersectRay(entities, camera_position, mouse_ray);
+        for(uint32_t i=0; i<entities.size(); i++) entities[i]->selected = i == selected_entity;
 
-                struct SELECTION_ID {
-                    uint32_t count;
-                    uint32_t id;
-                };
+        if(selected_entity != UINT32_MAX) {
 
-                selected_entity = entity;
-                entity->selected = true;
-                SELECTION_ID selection = {1, entity->InstanceId()};
-                GlobalData::GetInstance()->selection_descriptor.WriteData(&selection, sizeof(SELECTION_ID), 0);
-            }else {
-                entity->selected = false;
-            }
-        }
+            struct SELECTION_ID {
+                uint32_t count;
+                uint32_t id;
+            };
 
-        if(selected_entity == nullptr) {
+            SELECTION_ID selection = {1, entities[selected_entity]->InstanceId()};
+            GlobalData::GetInstance()->selection_descriptor.WriteData(&selection, sizeof(SELECTION_ID), 0);
+        }else{
             uint32_t count = 0;
             GlobalData::GetInstance()->selection_descriptor.WriteData(&count, sizeof(uint32_t), 0);
         }
@@ -398,13 +591,25 @@ namespace Engine
 
         std::chrono::steady_clock::time_point monitor_wait_draw = std::chrono::steady_clock::now();
 
+        this->DispatchAnimationEvents(frame_index);
         Timer::Update(frame_index);
         bool skeleton_updated = GlobalData::GetInstance()->skeleton_descriptor.Update(frame_index);
         bool indirect_updated = GlobalData::GetInstance()->indirect_descriptor.Update(frame_index);
         bool lod_updated = GlobalData::GetInstance()->lod_descriptor.Update(frame_index);
         bool selection_updated = GlobalData::GetInstance()->selection_descriptor.Update(frame_index);
-
-        if(skeleton_updated || indirect_updated || lod_updated) this->cull_lod_shader.Refresh(frame_index);
+        bool animation_event_updated = GlobalData::GetInstance()->animation_event_descriptor.Update(frame_index);
+        bool vertex_animation_updated = GlobalData::GetInstance()->vertex_animation_descriptor.Update(frame_index);
+
+        if(skeleton_updated || indirect_updated || lod_updated || animation_event_updated) this->cull_lod_shader.Refresh(frame_index);
+        if(skeleton_updated) this->palette_shader.Refresh(frame_index);
+        if(vertex_animation_updated) DynamicEntityRenderer::GetInstance()->Refresh();
+
+        // Palette slots are handed out again by the culling pass
+        if(GlobalData::GetInstance()->runtime_node_count > 0) {
+            uint32_t palette_count = 0;
+            GlobalData::GetInstance()->skeleton_descriptor.WriteData(&palette_count, sizeof(uint32_t), offsetof(GlobalData::PALETTE_HEADER, count), SKELETON_PALETTE_BINDING, frame_index);
+            GlobalData::GetInstance()->skeleton_descriptor.WriteData(&palette_count, sizeof(uint32_t), offsetof(GlobalData::PALETTE_HEADER, matrix_count), SKELETON_PALETTE_BINDING, frame_index);
+        }
 
         std::chrono::steady_clock::time_point monitor_descriptor_updates = std::chrono::steady_clock::now();
 
@@ -419,12 +624,17 @@ namespace Engine
 
         uint32_t lod_count = DynamicEntityRenderer::GetInstance()->GetLodCount();
         uint32_t group_count = MovementController::GetInstance()->GroupCount();
-        uint32_t entity_count = static_cast<uint32_t>(DynamicEntityRenderer::GetInstance()->GetEntities().size());
+        // Released slots stay in the range, their records no longer move nor collide
+        uint32_t entity_count = GlobalData::GetInstance()->dynamic_entity_slots.GetUpperBound();
         VkSemaphore wait_semaphore;
+        VkPipelineStageFlags wait_stage;
         if(lod_count > 0 || group_count > 0 || entity_count > 0) {
             
             std::vector<VkCommandBuffer> shader_command_buffers;
             wait_semaphore = this->compute_semaphores[frame_index];
+
+            // Indirect commands and bone palettes are written by the compute queue
+            wait_stage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
             
             if(lod_count > 0) {
                 std::array<uint32_t,3> cull_lod_shader_count = {lod_count, 1, 1};
@@ -435,12 +645,30 @@ namespace Engine
                     GlobalData::GetInstance()->dynamic_entity_descriptor.Get(),
                     GlobalData::GetInstance()->indirect_descriptor.Get(frame_index),
                     GlobalData::GetInstance()->lod_descriptor.Get(frame_index),
-                    GlobalData::GetInstance()->time_descriptor.Get(frame_index)
+                    GlobalData::GetInstance()->time_descriptor.Get(frame_index),
+                    GlobalData::GetInstance()->skeleton_descriptor.Get(frame_index),
+                    GlobalData::GetInstance()->animation_event_descriptor.Get(frame_index)
                 };
             
                 shader_command_buffers.push_back(
                     this->cull_lod_shader.BuildCommandBuffer(frame_index, cull_lod_descriptor_sets, cull_lod_shader_count)
                 );
+
+                if(GlobalData::GetInstance()->runtime_node_count > 0) {
+                    std::array<uint32_t,3> palette_shader_count = {(SKINNING_PALETTE_CAPACITY + 63) / 64, GlobalData::GetInstance()->runtime_node_count, 1};
+                    if(palette_shader_count != this->palette_shader.GetCount(frame_index)) this->palette_shader.Refresh(frame_index);
+
+                    std::vector<VkDescriptorSet> palette_descriptor_sets = {
+                        GlobalData::GetInstance()->dynamic_entity_descriptor.Get(),
+                        GlobalData::GetInstance()->time_descriptor.Get(frame_index),
+                        GlobalData::GetInstance()->skeleton_descriptor.Get(frame_index),
+                        GlobalData::GetInstance()->animation_tracks_descriptor.Get()
+                    };
+
+                    shader_command_buffers.push_back(
+                        this->palette_shader.BuildCommandBuffer(frame_index, palette_descriptor_sets, palette_shader_count)
+                    );
+                }
             }
 
             if(group_count > 0 && entity_count > 0) {
@@ -482,6 +710,7 @@ namespace Engine
             );
         }else{
             wait_semaphore = this->present_semaphores[semaphore_index];
+            wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         }
 
         std::chrono::steady_clock::time_point monitor_submit_compute = std::chrono::steady_clock::now();
@@ -497,7 +726,7 @@ namespace Engine
         vk::SubmitQueue(
             submit_command_buffers,
             {wait_semaphore},
-            {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT},
+            {wait_stage},
             {this->resources[frame_index].draw_semaphore},
             Vulkan::GetGraphicsQueue().handle,
             this->resources[frame_index].fence
@@ -14,10 +14,11 @@
 #include "../UserInterface/UserInterface.h"
 #include "../Map/Map.h"
 #include "../MovementController/MovementController.h"
+#include "IAnimationListener.h"
 
 namespace Engine
 {
-    class Core : public Singleton<Core>, public IMappedDescriptorListener, public IUserInteraction
+    class Core : public Singleton<Core>, public IMappedDescriptorListener, public IUserInteraction, public Tools::EventEmitter<IAnimationListener>
     {
         friend Singleton<Core>;
 
@@ -30,7 +31,7 @@ namespace Engine
             void Loop();
 
             inline bool LoadTexture(Tools::IMAGE_MAP image, std::string name) { return GlobalData::GetInstance()->texture_descriptor.AllocateTexture(image, name); }
-            bool LoadSkeleton(Model::Bone skeleton);
+            bool LoadSkeleton(std::shared_ptr<Model::FlatSkeleton> skeleton, GlobalData::SKINNING_MODE mode = GlobalData::SKINNING_MODE::BAKED_PALETTE);
             bool LoadModel(LODGroup& lod);
             bool AddToScene(DynamicEntity& entity);
 
@@ -65,10 +66,13 @@ namespace Engine
             ComputeShader cull_lod_shader;
             ComputeShader movement_shader;
             ComputeShader collision_shader;
+            ComputeShader palette_shader;
+            std::shared_ptr<Chunk> palette_chunk;
 
             Core();
             ~Core();
 
             bool BuildRenderPass(uint32_t frame_index);
+            void DispatchAnimationEvents(uint32_t frame_index);
     };
 }
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine
+{
+    class IAnimationListener
+    {
+        public :
+            virtual void AnimationFinished(uint32_t entity_id, uint32_t animation_id) = 0;
+    };
+}
\ No newline at end of file
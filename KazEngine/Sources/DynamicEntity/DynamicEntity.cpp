@@ -1,79 +1,91 @@
 #include "DynamicEntity.h"
+#include "../DynamicEntityRenderer/DynamicEntityRenderer.h"
 
 namespace Engine
 {
     DynamicEntity::DynamicEntity()
     {
-        this->selected  = false;
-        this->matrix    = nullptr;
-        this->frame     = nullptr;
-        this->animation = nullptr;
-        this->instance_id = UINT32_MAX;
-
-        auto matrix_chunk = GlobalData::GetInstance()->dynamic_entity_descriptor.ReserveRange(sizeof(Maths::Matrix4x4), ENTITY_MATRIX_BINDING);
-        if(matrix_chunk == nullptr) return;
-
-        auto frame_chunk = GlobalData::GetInstance()->dynamic_entity_descriptor.ReserveRange(sizeof(FRAME_DATA), ENTITY_FRAME_BINDING);
-        if(frame_chunk == nullptr) return;
-
-        auto animation_chunk = GlobalData::GetInstance()->dynamic_entity_descriptor.ReserveRange(sizeof(ANIMATION_DATA), ENTITY_ANIMATION_BINDING);
-        if(animation_chunk == nullptr) return;
-
-        auto movement_chunk = GlobalData::GetInstance()->dynamic_entity_descriptor.ReserveRange(sizeof(MOVEMENT_DATA), ENTITY_MOVEMENT_BINDING);
-        if(movement_chunk == nullptr) return;
-
-        this->instance_id = static_cast<uint32_t>(matrix_chunk->offset / sizeof(Maths::Matrix4x4));
-        this->matrix = reinterpret_cast<Maths::Matrix4x4*>(GlobalData::GetInstance()->dynamic_entity_descriptor.AccessData(this->instance_id * sizeof(Maths::Matrix4x4), ENTITY_MATRIX_BINDING));
-        this->frame = reinterpret_cast<FRAME_DATA*>(GlobalData::GetInstance()->dynamic_entity_descriptor.AccessData(this->instance_id * sizeof(FRAME_DATA), ENTITY_FRAME_BINDING));
-        this->animation = reinterpret_cast<ANIMATION_DATA*>(GlobalData::GetInstance()->dynamic_entity_descriptor.AccessData(this->instance_id * sizeof(ANIMATION_DATA), ENTITY_ANIMATION_BINDING));
-        this->movement = reinterpret_cast<MOVEMENT_DATA*>(GlobalData::GetInstance()->dynamic_entity_descriptor.AccessData(this->instance_id * sizeof(MOVEMENT_DATA), ENTITY_MOVEMENT_BINDING));
-
-        *this->matrix = IDENTITY_MATRIX;
-        *this->frame = {};
-        *this->animation = {};
-        (*this->movement).destination = {};
-        (*this->movement).moving = -1;
-        (*this->movement).radius = 0.5f;
-
-        GlobalData::GetInstance()->dynamic_entity_descriptor.AddListener(this);
+        this->selected = false;
+
+        // Once the preallocated slots are used, the bindings grow by blocks of records
+        SlotAllocator& slots = GlobalData::GetInstance()->dynamic_entity_slots;
+        if(slots.GetCount() == slots.GetCapacity()) GlobalData::GetInstance()->ReserveDynamicEntitySlots(UNIT_GROWTH_COUNT);
+
+        this->slot = slots.Allocate();
+        if(this->slot.index == UINT32_MAX) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "DynamicEntity() : Not enough memory" << std::endl;
+            #endif
+            return;
+        }
+
+        this->Matrix() = IDENTITY_MATRIX;
+        this->Frame() = {};
+        this->Animation() = {};
+        this->Animation().generation = this->slot.generation;
+        this->Movement().destination = {};
+        this->Movement().moving = -1;
+        this->Movement().radius = 0.5f;
     }
 
-    void DynamicEntity::MappedDescriptorSetUpdated(MappedDescriptorSet* descriptor, uint8_t binding)
+    DynamicEntity::~DynamicEntity()
     {
-        switch(binding) {
-
-            case ENTITY_MATRIX_BINDING :
-                this->matrix = reinterpret_cast<Maths::Matrix4x4*>(descriptor->AccessData(this->instance_id * sizeof(Maths::Matrix4x4), binding));
-                break;
-
-            case ENTITY_FRAME_BINDING :
-                this->frame = reinterpret_cast<FRAME_DATA*>(descriptor->AccessData(this->instance_id * sizeof(FRAME_DATA), binding));
-                break;
+        // Entities may outlive the engine
+        if(GlobalData::GetInstance() == nullptr || this->slot.index == UINT32_MAX) return;
 
-            case ENTITY_ANIMATION_BINDING :
-                this->animation = reinterpret_cast<ANIMATION_DATA*>(descriptor->AccessData(this->instance_id * sizeof(ANIMATION_DATA), binding));
-                break;
+        // The slot may be handed out again, nothing must reference it anymore
+        if(DynamicEntityRenderer::GetInstance() != nullptr) DynamicEntityRenderer::GetInstance()->RemoveFromScene(*this);
+        this->Movement().moving = -1;
+        this->Movement().radius = 0.0f;
 
-            case ENTITY_MOVEMENT_BINDING :
-                this->movement = reinterpret_cast<MOVEMENT_DATA*>(descriptor->AccessData(this->instance_id * sizeof(MOVEMENT_DATA), binding));
-                break;
-        }
+        GlobalData::GetInstance()->dynamic_entity_slots.Free(this->slot);
     }
 
-    void DynamicEntity::PlayAnimation(std::string animation, float speed, bool loop)
+    void DynamicEntity::PlayAnimation(std::string animation, float speed, bool loop, uint32_t blend_duration)
     {
-        if(GlobalData::GetInstance()->animations.count(animation)) {
-            this->animation->speed = speed;
+        if(this->slot.index == UINT32_MAX) return;
+
+        // Animation ids are local to the skeleton of the entity
+        GlobalData::BAKED_ANIMATION const* clip = nullptr;
+        for(auto lod : this->models) {
+            auto skeleton = GlobalData::GetInstance()->skeletons.find(lod->GetSkeleton());
+            if(skeleton == GlobalData::GetInstance()->skeletons.end()) continue;
+            auto found = skeleton->second.animations.find(animation);
+            if(found != skeleton->second.animations.end()) clip = &found->second;
+            break;
+        }
 
-            this->frame->frame_id = 0;
-            this->frame->animation_id = GlobalData::GetInstance()->animations[animation].animation_id;
-            this->animation->frame_count = GlobalData::GetInstance()->animations[animation].frame_count;
-            this->animation->duration = static_cast<uint32_t>(GlobalData::GetInstance()->animations[animation].duration.count());
+        if(clip != nullptr) {
+            FRAME_DATA& frame = this->Frame();
+            ANIMATION_DATA& animation_data = this->Animation();
+            uint32_t now = static_cast<uint32_t>(Timer::EngineStartDuration().count());
+
+            // The running clip fades out, weights are evaluated by the compute shaders
+            if(blend_duration > 0 && animation_data.play) {
+                frame.previous_animation_id = frame.animation_id;
+                animation_data.previous_frame_count = animation_data.frame_count;
+                animation_data.previous_loop = animation_data.loop;
+                animation_data.previous_play = animation_data.play;
+                animation_data.previous_duration = animation_data.duration;
+                animation_data.previous_start = animation_data.start;
+                animation_data.previous_speed = animation_data.speed;
+                animation_data.blend_start = now;
+                animation_data.blend_duration = blend_duration;
+            }else{
+                animation_data.blend_duration = 0;
+            }
 
-            this->animation->loop = loop ? 1 : 0;
-            this->animation->play = 1;
+            animation_data.speed = speed;
 
-            this->animation->start = static_cast<uint32_t>(Timer::EngineStartDuration().count());
+            frame.frame_id = 0;
+            frame.animation_id = clip->animation_id;
+            animation_data.frame_count = clip->frame_count;
+            animation_data.duration = static_cast<uint32_t>(clip->duration.count());
+
+            animation_data.loop = loop ? 1 : 0;
+            animation_data.play = 1;
+
+            animation_data.start = now;
         }
     }
 
@@ -81,8 +93,8 @@ namespace Engine
     {
         for(auto& lod : this->models) {
             if(lod->GetHitBox() != nullptr) {
-                Maths::Vector3 box_min = *this->matrix * lod->GetHitBox()->near_left_bottom_point;
-                Maths::Vector3 box_max = *this->matrix * lod->GetHitBox()->far_right_top_point;
+                Maths::Vector3 box_min = this->Matrix() * lod->GetHitBox()->near_left_bottom_point;
+                Maths::Vector3 box_max = this->Matrix() * lod->GetHitBox()->far_right_top_point;
                 if(Maths::aabb_inside_half_space(left_plane, box_min, box_max) && Maths::aabb_inside_half_space(right_plane, box_min, box_max)
                 && Maths::aabb_inside_half_space(top_plane, box_min, box_max) && Maths::aabb_inside_half_space(bottom_plane, box_min, box_max))
                     return true;
@@ -97,8 +109,8 @@ namespace Engine
         for(auto& lod : this->models) {
             if(lod->GetHitBox() != nullptr) {
                 if(Maths::ray_box_aabb_intersect(ray_origin, ray_direction,
-                                                 *this->matrix * lod->GetHitBox()->near_left_bottom_point,
-                                                 *this->matrix * lod->GetHitBox()->far_right_top_point,
+                                                 this->Matrix() * lod->GetHitBox()->near_left_bottom_point,
+                                                 this->Matrix() * lod->GetHitBox()->far_right_top_point,
                                                  -2000.0f, 2000.0f))
                     return true;
             }
@@ -106,4 +118,67 @@ namespace Engine
 
         return false;
     }
+
+    /**
+     * Hit-boxes of every entity in world space, in the same order as the entities
+     * @param entities Entities to test
+     * @param[out] boxes One box per model having a hit-box
+     * @param[out] owners Index of the entity owning each box
+     */
+    void DynamicEntity::TransformHitBoxes(std::vector<DynamicEntity*> const& entities, Maths::Batch::BOXES& boxes, std::vector<uint32_t>& owners)
+    {
+        size_t count = 0;
+        for(auto entity : entities)
+            for(auto lod : entity->models)
+                if(lod->GetHitBox() != nullptr) count++;
+
+        std::vector<Maths::Matrix4x4 const*> matrices(count);
+        Maths::Batch::BOXES local_boxes;
+        local_boxes.Resize(count);
+        owners.resize(count);
+
+        size_t box_id = 0;
+        for(uint32_t i=0; i<entities.size(); i++) {
+            for(auto lod : entities[i]->models) {
+                if(lod->GetHitBox() == nullptr) continue;
+                matrices[box_id] = &entities[i]->Matrix();
+                local_boxes.min.Set(box_id, lod->GetHitBox()->near_left_bottom_point);
+                local_boxes.max.Set(box_id, lod->GetHitBox()->far_right_top_point);
+                owners[box_id] = i;
+                box_id++;
+            }
+        }
+
+        Maths::Batch::TransformBoxes(matrices.data(), local_boxes, boxes);
+    }
+
+    void DynamicEntity::InSelectBox(std::vector<DynamicEntity*> const& entities, std::array<Maths::Plane, 4> const& planes, std::vector<uint8_t>& inside)
+    {
+        Maths::Batch::BOXES boxes;
+        std::vector<uint32_t> owners;
+        DynamicEntity::TransformHitBoxes(entities, boxes, owners);
+
+        std::vector<uint8_t> boxes_inside;
+        Maths::Batch::BoxesInsideHalfSpaces(boxes, planes.data(), static_cast<uint8_t>(planes.size()), boxes_inside);
+
+        inside.assign(entities.size(), 0);
+        for(size_t i=0; i<boxes_inside.size(); i++)
+            if(boxes_inside[i]) inside[owners[i]] = 1;
+    }
+
+    uint32_t DynamicEntity::IntersectRay(std::vector<DynamicEntity*> const& entities, Maths::Vector3 const& ray_origin, Maths::Vector3 const& ray_direction)
+    {
+        Maths::Batch::BOXES boxes;
+        std::vector<uint32_t> owners;
+        DynamicEntity::TransformHitBoxes(entities, boxes, owners);
+
+        std::vector<uint8_t> hits;
+        Maths::Batch::RayIntersectBoxes(ray_origin, ray_direction, boxes, -2000.0f, 2000.0f, hits);
+
+        // Boxes follow the entity order, the first hit is the first entity hit
+        for(size_t i=0; i<hits.size(); i++)
+            if(hits[i]) return owners[i];
+
+        return UINT32_MAX;
+    }
 }
\ No newline at end of file
@@ -3,21 +3,24 @@
 #include <list>
 #include <Maths.h>
 #include "../LOD/LOD.h"
-#include "../MappedDescriptorSet/IMappedDescriptorListener.h"
 #include "../GlobalData/GlobalData.h"
 #include "../Platform/Common/Timer/Timer.h"
 // #include "../MovementControler/MovementControler.h"
 
 namespace Engine
 {
-    class DynamicEntity : public IMappedDescriptorListener
+    class DynamicEntity
     {
         public :
 
             struct FRAME_DATA {
                 uint32_t animation_id;
                 uint32_t frame_id;
-                FRAME_DATA() : animation_id(0), frame_id(0) {}
+                uint32_t previous_animation_id;     // Clip faded out during a crossfade
+                uint32_t previous_frame_id;
+                float blend_weight;                 // Weight of the current clip, 1 outside of a crossfade
+                uint32_t vertex_animation;          // Baked positions of the selected LOD, written by the culling pass
+                FRAME_DATA() : animation_id(0), frame_id(0), previous_animation_id(0), previous_frame_id(0), blend_weight(1.0f), vertex_animation(UINT32_MAX) {}
             };
 
             struct ANIMATION_DATA {
@@ -27,7 +30,19 @@ namespace Engine
                 uint32_t duration;
                 uint32_t start;
                 float speed;
-                ANIMATION_DATA() : frame_count(0), loop(0), play(0), duration(0), start(0), speed(0.0f) {}
+                uint32_t previous_frame_count;
+                uint32_t previous_loop;
+                uint32_t previous_play;
+                uint32_t previous_duration;
+                uint32_t previous_start;
+                float previous_speed;
+                uint32_t blend_start;
+                uint32_t blend_duration;            // Crossfade duration in milliseconds, 0 for a hard switch
+                uint32_t completed_start;           // Written by the GPU : start + 1 of the last play once clip reported as finished
+                uint32_t generation;                // Generation of the slot, copied into the completion events
+                ANIMATION_DATA() : frame_count(0), loop(0), play(0), duration(0), start(0), speed(0.0f),
+                                   previous_frame_count(0), previous_loop(0), previous_play(0), previous_duration(0), previous_start(0), previous_speed(0.0f),
+                                   blend_start(0), blend_duration(0), completed_start(0), generation(0) {}
             };
 
             struct MOVEMENT_DATA {
@@ -39,31 +54,41 @@ namespace Engine
             bool selected;
 
             DynamicEntity();
+            ~DynamicEntity();
+            DynamicEntity(DynamicEntity const&) = delete;
+            DynamicEntity& operator=(DynamicEntity const&) = delete;
             void AddModel(LODGroup* lod) { this->models.push_back(lod); }
             std::vector<LODGroup*> const GetModels() { return this->models; }
-            uint32_t InstanceId() const { return this->instance_id; }
-            void PlayAnimation(std::string animation, float speed, bool loop);
+            uint32_t InstanceId() const { return this->slot.index; }
+            SlotAllocator::SLOT const& Slot() const { return this->slot; }
+            void PlayAnimation(std::string animation, float speed, bool loop, uint32_t blend_duration = 0);
             bool InSelectBox(Maths::Plane left_plane, Maths::Plane right_plane, Maths::Plane top_plane, Maths::Plane bottom_plane);
             bool IntersectRay(Maths::Vector3 const& ray_origin, Maths::Vector3 const& ray_direction);
 
-            Maths::Matrix4x4& Matrix() { return *this->matrix; }
-            FRAME_DATA& Frame() { return *this->frame; }
-            ANIMATION_DATA& Animation() { return *this->animation; }
-            MOVEMENT_DATA& Movement() { return *this->movement; }
+            /// Batch version of InSelectBox, one value per entity, 1 if the entity is in the box
+            static void InSelectBox(std::vector<DynamicEntity*> const& entities, std::array<Maths::Plane, 4> const& planes, std::vector<uint8_t>& inside);
 
-            // IDescriptorListener
-            void MappedDescriptorSetUpdated(MappedDescriptorSet* descriptor, uint8_t binding);
+            /// Batch version of IntersectRay, index of the first entity hit, UINT32_MAX if none
+            static uint32_t IntersectRay(std::vector<DynamicEntity*> const& entities, Maths::Vector3 const& ray_origin, Maths::Vector3 const& ray_direction);
+
+            /// Entity records, only valid if the instance id is not UINT32_MAX
+            /// @{
+            Maths::Matrix4x4& Matrix() { return *reinterpret_cast<Maths::Matrix4x4*>(this->Record(sizeof(Maths::Matrix4x4), ENTITY_MATRIX_BINDING)); }
+            FRAME_DATA& Frame() { return *reinterpret_cast<FRAME_DATA*>(this->Record(sizeof(FRAME_DATA), ENTITY_FRAME_BINDING)); }
+            ANIMATION_DATA& Animation() { return *reinterpret_cast<ANIMATION_DATA*>(this->Record(sizeof(ANIMATION_DATA), ENTITY_ANIMATION_BINDING)); }
+            MOVEMENT_DATA& Movement() { return *reinterpret_cast<MOVEMENT_DATA*>(this->Record(sizeof(MOVEMENT_DATA), ENTITY_MOVEMENT_BINDING)); }
+            /// @}
 
         private :
 
             friend class GlobalData;
 
             std::vector<LODGroup*> models;
-            uint32_t instance_id;
+            SlotAllocator::SLOT slot;
+
+            /// Records are looked up on every access, the bindings are relocated when they grow
+            void* Record(size_t stride, uint8_t binding) { return GlobalData::GetInstance()->dynamic_entity_descriptor.AccessData(this->slot.index * stride, binding); }
 
-            Maths::Matrix4x4* matrix;
-            FRAME_DATA* frame;
-            ANIMATION_DATA* animation;
-            MOVEMENT_DATA* movement;
+            static void TransformHitBoxes(std::vector<DynamicEntity*> const& entities, Maths::Batch::BOXES& boxes, std::vector<uint32_t>& owners);
     };
 }
@@ -13,58 +13,94 @@ namespace Engine
         for(auto& command_buffer : this->command_buffers)
             if(!vk::CreateCommandBuffer(this->command_pool, command_buffer, VK_COMMAND_BUFFER_LEVEL_SECONDARY)) return;
 
+        for(uint8_t i=0; i<INFLUENCE_VARIANT_COUNT; i++) {
+            if(!this->CreatePipeline(Model::CookedMesh::FLOAT_VERTEX, 1 << i, this->pipelines[i])) return;
+            if(!this->CreatePipeline(Model::CookedMesh::COMPACT_VERTEX, 1 << i, this->compact_pipelines[i])) return;
+        }
+
+        GlobalData::GetInstance()->indirect_descriptor.AddListener(this);
+        GlobalData::GetInstance()->skeleton_descriptor.AddListener(this);
+        GlobalData::GetInstance()->dynamic_entity_descriptor.AddListener(this);
+        GlobalData::GetInstance()->vertex_animation_descriptor.AddListener(this);
+    }
+
+    DynamicEntityRenderer::~DynamicEntityRenderer()
+    {
+        GlobalData::GetInstance()->vertex_animation_descriptor.RemoveListener(this);
+        GlobalData::GetInstance()->dynamic_entity_descriptor.RemoveListener(this);
+        GlobalData::GetInstance()->skeleton_descriptor.RemoveListener(this);
+        GlobalData::GetInstance()->indirect_descriptor.RemoveListener(this);
+
+        vk::Destroy(this->command_pool);
+        for(auto& pipeline : this->pipelines) vk::Destroy(pipeline);
+        for(auto& pipeline : this->compact_pipelines) vk::Destroy(pipeline);
+    }
+
+    bool DynamicEntityRenderer::CreatePipeline(Model::CookedMesh::VERTEX_FORMAT format, uint32_t max_influences, vk::PIPELINE& pipeline)
+    {
+        bool compact = format == Model::CookedMesh::COMPACT_VERTEX;
+
         std::vector<VkPipelineShaderStageCreateInfo> shader_stages = {
-            vk::LoadShaderModule("./Shaders/dynamic_model.vert.spv", VK_SHADER_STAGE_VERTEX_BIT),
+            vk::LoadShaderModule(compact ? "./Shaders/dynamic_model_compact.vert.spv" : "./Shaders/dynamic_model.vert.spv", VK_SHADER_STAGE_VERTEX_BIT),
             vk::LoadShaderModule("./Shaders/textured_model.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT)
         };
 
+        // Bones read per vertex, meshes with fewer influences skip the empty ones
+        VkSpecializationMapEntry specialization_entry = {0, 0, sizeof(uint32_t)};
+        VkSpecializationInfo specialization_info = {1, &specialization_entry, sizeof(uint32_t), &max_influences};
+        shader_stages[0].pSpecializationInfo = &specialization_info;
+
         std::vector<VkVertexInputBindingDescription> vertex_binding_description;
         std::vector<VkVertexInputAttributeDescription> vertex_attribute_description = vk::CreateVertexInputDescription({
-            {vk::POSITION, vk::UV, vk::BONE_WEIGHTS, vk::BONE_IDS},
+            compact ? std::vector<vk::VERTEX_BINDING_ATTRIBUTE>{vk::POSITION_UNORM16, vk::UV_UNORM16, vk::BONE_WEIGHTS_UNORM8, vk::BONE_IDS_UINT8}
+                    : std::vector<vk::VERTEX_BINDING_ATTRIBUTE>{vk::POSITION, vk::UV, vk::BONE_WEIGHTS, vk::BONE_IDS},
             {vk::MATRIX},
-            {vk::UINT_ID, vk::UINT_ID}
+            {vk::UINT_ID, vk::UINT_ID, vk::UINT_ID, vk::UINT_ID, vk::FLOAT_VALUE, vk::UINT_ID}
         }, vertex_binding_description);
 
+        // Both pipelines share the same layout, so descriptor sets stay bound when switching
+        VkPushConstantRange push_constant_range = {};
+        push_constant_range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+        push_constant_range.offset = 0;
+        push_constant_range.size = sizeof(LODGroup::PUSH_CONSTANT_DRAW);
+
         bool success = vk::CreateGraphicsPipeline(
             true,
             {
                 GlobalData::GetInstance()->texture_descriptor.GetLayout(),
                 GlobalData::GetInstance()->camera_descriptor.GetLayout(),
-                GlobalData::GetInstance()->skeleton_descriptor.GetLayout()
+                GlobalData::GetInstance()->skeleton_descriptor.GetLayout(),
+                GlobalData::GetInstance()->vertex_animation_descriptor.GetLayout()
             },
-            shader_stages, vertex_binding_description, vertex_attribute_description, {}, this->pipeline
+            shader_stages, vertex_binding_description, vertex_attribute_description, {push_constant_range}, pipeline
         );
 
         for(auto& stage : shader_stages) vk::Destroy(stage);
 
-        GlobalData::GetInstance()->indirect_descriptor.AddListener(this);
-        GlobalData::GetInstance()->skeleton_descriptor.AddListener(this);
-        GlobalData::GetInstance()->dynamic_entity_descriptor.AddListener(this);
-    }
-
-    DynamicEntityRenderer::~DynamicEntityRenderer()
-    {
-        GlobalData::GetInstance()->dynamic_entity_descriptor.RemoveListener(this);
-        GlobalData::GetInstance()->skeleton_descriptor.RemoveListener(this);
-        GlobalData::GetInstance()->indirect_descriptor.RemoveListener(this);
-
-        vk::Destroy(this->command_pool);
-        vk::Destroy(this->pipeline);
+        return success;
     }
 
     bool DynamicEntityRenderer::AddToScene(DynamicEntity& entity)
     {
+        if(entity.InstanceId() == UINT32_MAX) return false;
+
+        size_t first_command = this->draw_commands.size();
         for(auto lod : entity.GetModels()) {
             auto chunk = GlobalData::GetInstance()->indirect_descriptor.ReserveRange(sizeof(LODGroup::INDIRECT_COMMAND));
-            if(chunk == nullptr) return false;
-
-            LODGroup::INDIRECT_COMMAND indirect;
-            indirect.firstInstance = entity.InstanceId();
-            indirect.lodIndex = lod->GetLodIndex();
-            indirect.firstVertex = 0;
-            indirect.instanceCount = 1;
-            indirect.vertexCount = 4500;
-            GlobalData::GetInstance()->indirect_descriptor.WriteData(&indirect, sizeof(LODGroup::INDIRECT_COMMAND), static_cast<uint32_t>(chunk->offset));
+            if(chunk == nullptr) {
+
+                // The entity is not in the scene, RemoveFromScene would never release its first commands
+                while(this->draw_commands.size() > first_command) {
+                    GlobalData::GetInstance()->indirect_descriptor.FreeChunk(this->draw_commands.back().chunk);
+                    this->draw_commands.pop_back();
+                    this->lod_count--;
+                }
+                return false;
+            }
+
+            DRAW_COMMAND command = {lod, entity.InstanceId(), chunk, chunk->offset};
+            this->WriteIndirectCommand(command);
+            this->draw_commands.push_back(command);
             this->lod_count++;
         }
 
@@ -74,6 +110,52 @@ namespace Engine
         return true;
     }
 
+    /**
+     * Stop drawing an entity, its instance id may be handed out again afterwards
+     * @retval false if the entity is not in the scene
+     */
+    bool DynamicEntityRenderer::RemoveFromScene(DynamicEntity& entity)
+    {
+        auto found = std::find(this->entities.begin(), this->entities.end(), &entity);
+        if(found == this->entities.end()) return false;
+        this->entities.erase(found);
+
+        // The culling shader reads lod_count packed commands : commands are appended in offset order,
+        // the last one fills the hole and its chunk is released so that the next command reuses it
+        for(uint32_t i=0; i<this->draw_commands.size();) {
+            if(this->draw_commands[i].instance_id != entity.InstanceId()) {
+                i++;
+                continue;
+            }
+
+            DRAW_COMMAND& last = this->draw_commands.back();
+            if(&last != &this->draw_commands[i]) {
+                this->draw_commands[i].lod = last.lod;
+                this->draw_commands[i].instance_id = last.instance_id;
+                this->WriteIndirectCommand(this->draw_commands[i]);
+            }
+
+            GlobalData::GetInstance()->indirect_descriptor.FreeChunk(last.chunk);
+            this->draw_commands.pop_back();
+            this->lod_count--;
+        }
+
+        this->Refresh();
+        return true;
+    }
+
+    void DynamicEntityRenderer::WriteIndirectCommand(DRAW_COMMAND const& command)
+    {
+        LODGroup::INDIRECT_COMMAND indirect;
+        indirect.firstInstance = command.instance_id;
+        indirect.lodIndex = command.lod->GetLodIndex();
+        indirect.firstIndex = 0;
+        indirect.vertexOffset = 0;
+        indirect.instanceCount = 1;
+        indirect.indexCount = 0;
+        GlobalData::GetInstance()->indirect_descriptor.WriteData(&indirect, sizeof(LODGroup::INDIRECT_COMMAND), static_cast<uint32_t>(command.indirect_offset));
+    }
+
     VkCommandBuffer DynamicEntityRenderer::BuildCommandBuffer(uint8_t frame_index, VkFramebuffer framebuffer)
     {
         VkCommandBuffer command_buffer = this->command_buffers[frame_index];
@@ -117,16 +199,16 @@ namespace Engine
         scissor.extent.height = surface.height;
         vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 
-        vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->pipeline.handle);
-
         std::vector<VkDescriptorSet> bind_descriptor_sets = {
             GlobalData::GetInstance()->texture_descriptor.Get(),
             GlobalData::GetInstance()->camera_descriptor.Get(frame_index),
-            GlobalData::GetInstance()->skeleton_descriptor.Get(frame_index)
+            GlobalData::GetInstance()->skeleton_descriptor.Get(frame_index),
+            GlobalData::GetInstance()->vertex_animation_descriptor.Get(frame_index)
         };
 
+        // Every variant has a compatible layout, the sets stay bound when switching pipelines
         vkCmdBindDescriptorSets(
-            command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.layout, 0,
+            command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->pipelines[0].layout, 0,
             static_cast<uint32_t>(bind_descriptor_sets.size()), bind_descriptor_sets.data(), 0, nullptr
         );
 
@@ -144,13 +226,39 @@ namespace Engine
 
         vkCmdBindVertexBuffers(command_buffer, 0, static_cast<uint32_t>(offsets.size()), buffers.data(), offsets.data());
 
-        vkCmdDrawIndirect(
-            command_buffer,
-            GlobalData::GetInstance()->instanced_buffer.GetBuffer(frame_index).handle,
-            GlobalData::GetInstance()->indirect_descriptor.GetChunk()->offset,
-            this->lod_count,
-            sizeof(LODGroup::INDIRECT_COMMAND)
-        );
+        // Indirect commands are drawn by runs sharing the same LOD group, whose vertices and indices are bound at its own offset
+        VkBuffer buffer = GlobalData::GetInstance()->instanced_buffer.GetBuffer(frame_index).handle;
+        VkDeviceSize indirect_offset = GlobalData::GetInstance()->indirect_descriptor.GetChunk()->offset;
+        LODGroup* bound_group = nullptr;
+        vk::PIPELINE* bound_pipeline = nullptr;
+        for(uint32_t i=0; i<this->draw_commands.size();) {
+
+            LODGroup* lod = this->draw_commands[i].lod;
+            uint32_t count = 1;
+            while(i + count < this->draw_commands.size() && this->draw_commands[i + count].lod == lod
+                  && this->draw_commands[i + count].indirect_offset == this->draw_commands[i].indirect_offset + count * sizeof(LODGroup::INDIRECT_COMMAND)) count++;
+
+            uint8_t variant = DynamicEntityRenderer::InfluenceVariant(lod->GetMaxInfluences());
+            vk::PIPELINE* pipeline = lod->GetVertexFormat() == Model::CookedMesh::COMPACT_VERTEX ? &this->compact_pipelines[variant] : &this->pipelines[variant];
+            if(pipeline != bound_pipeline) {
+                vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline->handle);
+                bound_pipeline = pipeline;
+            }
+
+            if(lod != bound_group) {
+                // Skeleton of the group, the float pipeline ignores the dequantization
+                LODGroup::PUSH_CONSTANT_DRAW push_constant = {lod->GetDequantization(), lod->GetSkeletonID()};
+                vkCmdPushConstants(command_buffer, pipeline->layout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(LODGroup::PUSH_CONSTANT_DRAW), &push_constant);
+
+                VkDeviceSize vertex_offset = lod->GetVertexBufferOffset();
+                vkCmdBindVertexBuffers(command_buffer, 0, 1, &buffer, &vertex_offset);
+                vkCmdBindIndexBuffer(command_buffer, buffer, lod->GetIndexBufferOffset(), lod->GetIndexType());
+                bound_group = lod;
+            }
+
+            vkCmdDrawIndexedIndirect(command_buffer, buffer, indirect_offset + this->draw_commands[i].indirect_offset, count, sizeof(LODGroup::INDIRECT_COMMAND));
+            i += count;
+        }
 
         result = vkEndCommandBuffer(command_buffer);
         if(result != VK_SUCCESS) {
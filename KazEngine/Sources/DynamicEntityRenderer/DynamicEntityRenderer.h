@@ -18,6 +18,7 @@ namespace Engine
 
             VkCommandBuffer BuildCommandBuffer(uint8_t frame_index, VkFramebuffer framebuffer);
             bool AddToScene(DynamicEntity& entity);
+            bool RemoveFromScene(DynamicEntity& entity);
             uint32_t GetLodCount() const { return this->lod_count; }
             void Refresh() { std::fill(this->refresh.begin(), this->refresh.end(), true); }
             std::vector<DynamicEntity*> const& GetEntities() const { return this->entities; }
@@ -30,15 +31,30 @@ namespace Engine
 
         private :
 
+            /// Vertex shaders are specialized for 1, 2 or 4 bones per vertex
+            static constexpr uint8_t INFLUENCE_VARIANT_COUNT = 3;
+
+            struct DRAW_COMMAND {
+                LODGroup* lod;
+                uint32_t instance_id;
+                std::shared_ptr<Chunk> chunk;
+                VkDeviceSize indirect_offset;
+            };
+
             VkCommandPool command_pool;
             std::vector<bool> refresh;
             std::vector<VkCommandBuffer> command_buffers;
-            vk::PIPELINE pipeline;
+            std::array<vk::PIPELINE, INFLUENCE_VARIANT_COUNT> pipelines;
+            std::array<vk::PIPELINE, INFLUENCE_VARIANT_COUNT> compact_pipelines;
             uint32_t lod_count;
+            std::vector<DRAW_COMMAND> draw_commands;
 
             std::vector<DynamicEntity*> entities;
 
             DynamicEntityRenderer();
             ~DynamicEntityRenderer();
+            void WriteIndirectCommand(DRAW_COMMAND const& command);
+            bool CreatePipeline(Model::CookedMesh::VERTEX_FORMAT format, uint32_t max_influences, vk::PIPELINE& pipeline);
+            static uint8_t InfluenceVariant(uint8_t max_influences) { return max_influences <= 1 ? 0 : max_influences == 2 ? 1 : 2; }
     };
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "./Core/Core.h"
 #include "./Loader/Loader.h"
+#include "./Loader/AsyncLoader.h"
 #include "./LOD/LOD.h"
 #include "./DynamicEntity/DynamicEntity.h"
 
@@ -17,11 +17,16 @@ namespace Engine
         // SKELETON
         this->instance = this;
         this->skeleton_descriptor.Create({
-            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, SIZE_MEGABYTE(5)},  // BONES
-            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, SIZE_KILOBYTE(1)},  // OFFSET IDS
-            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, SIZE_MEGABYTE(1)},  // OFFSETS
-            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, SIZE_KILOBYTE(1)}   // ANIMATIONS
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT, SIZE_MEGABYTE(5)},   // BONES
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, SIZE_KILOBYTE(1)},                                  // OFFSET IDS
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, SIZE_MEGABYTE(1)},                                  // OFFSETS
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT, SIZE_KILOBYTE(1)},   // ANIMATIONS
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT,
+            sizeof(PALETTE_HEADER) + sizeof(uint32_t) * UNIT_PREALLOC_COUNT},                                                   // PALETTE
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, sizeof(uint32_t) * 2 * SKINNING_PALETTE_CAPACITY}, // PALETTE ENTITIES
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_COMPUTE_BIT, SIZE_KILOBYTE(1)}    // REGISTRY
         });
+        this->runtime_node_count = 0;
 
         // CAMERA
         this->camera_descriptor.Create({
@@ -46,6 +51,8 @@ namespace Engine
             {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, sizeof(DynamicEntity::ANIMATION_DATA) * UNIT_PREALLOC_COUNT},
             {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT, sizeof(DynamicEntity::MOVEMENT_DATA) * UNIT_PREALLOC_COUNT},
         });
+        this->dynamic_entity_slots.Reset(0);
+        this->ReserveDynamicEntitySlots(UNIT_PREALLOC_COUNT);
 
         // TIME
         this->time_descriptor.Create({
@@ -62,16 +69,69 @@ namespace Engine
             {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT | VK_SHADER_STAGE_COMPUTE_BIT, sizeof(uint32_t) * (UNIT_PREALLOC_COUNT + 1)},
         });
 
+        // ANIMATION EVENTS
+        this->animation_event_descriptor.Create({
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, sizeof(ANIMATION_EVENT_HEADER) + sizeof(ANIMATION_EVENT) * ANIMATION_EVENT_CAPACITY}
+        });
+        ANIMATION_EVENT_HEADER event_header = {0, ANIMATION_EVENT_CAPACITY, {}};
+        this->animation_event_descriptor.WriteData(&event_header, sizeof(ANIMATION_EVENT_HEADER), 0);
+
+        // VERTEX ANIMATIONS
+        this->vertex_animation_descriptor.Create({
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, SIZE_KILOBYTE(1)},     // RECORDS
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, SIZE_KILOBYTE(1)},     // ROWS
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, SIZE_MEGABYTE(1)}      // TEXELS
+        });
+
         // MOVEMENT
         this->group_descriptor.Create({
             {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(uint32_t)},
             {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(MovementController::MOVEMENT_GROUP)}
         });
 
+        // ANIMATION TRACKS
+        this->animation_tracks_descriptor.Create({
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, SIZE_KILOBYTE(64)},    // NODES
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, SIZE_MEGABYTE(1)},     // TRACKS
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, SIZE_MEGABYTE(1)},     // KEY TIMES
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, SIZE_MEGABYTE(2)}      // KEY VALUES
+        });
+
         // VERTEX BUFFER
         this->vertex_buffer = this->instanced_buffer.GetChunk()->ReserveRange(0);
     }
 
+    /**
+     * Extend the dynamic entity bindings by the same number of records and hand them to the slot allocator
+     * @param count Number of records added at the end of each binding
+     * @retval false if the mapped buffer could not hold the new records
+     */
+    bool GlobalData::ReserveDynamicEntitySlots(uint32_t count)
+    {
+        // Slot indices address the records directly, new records must follow the ones already handed out
+        std::array<size_t, 4> strides;
+        strides[ENTITY_MATRIX_BINDING] = sizeof(Maths::Matrix4x4);
+        strides[ENTITY_FRAME_BINDING] = sizeof(DynamicEntity::FRAME_DATA);
+        strides[ENTITY_ANIMATION_BINDING] = sizeof(DynamicEntity::ANIMATION_DATA);
+        strides[ENTITY_MOVEMENT_BINDING] = sizeof(DynamicEntity::MOVEMENT_DATA);
+
+        uint32_t capacity = this->dynamic_entity_slots.GetCapacity();
+        std::array<std::shared_ptr<Chunk>, 4> chunks;
+        for(uint8_t binding=0; binding<strides.size(); binding++) {
+            chunks[binding] = this->dynamic_entity_descriptor.ReserveRange(strides[binding] * count, binding);
+            if(chunks[binding] == nullptr || chunks[binding]->offset != strides[binding] * capacity) {
+
+                // Bindings must stay the same length, or the next attempt could never line up
+                for(uint8_t i=0; i<=binding; i++)
+                    if(chunks[i] != nullptr) this->dynamic_entity_descriptor.FreeChunk(chunks[i], i);
+                return false;
+            }
+        }
+
+        this->dynamic_entity_slots.Grow(count);
+        return true;
+    }
+
     GlobalData::~GlobalData()
     {
         this->lod_descriptor.Clear();
@@ -82,7 +142,10 @@ namespace Engine
         this->time_descriptor.Clear();
         this->mouse_square_descriptor.Clear();
         this->selection_descriptor.Clear();
+        this->animation_event_descriptor.Clear();
+        this->vertex_animation_descriptor.Clear();
         this->group_descriptor.Clear();
+        this->animation_tracks_descriptor.Clear();
 
         this->mapped_buffer.Clear();
         this->instanced_buffer.Clear();
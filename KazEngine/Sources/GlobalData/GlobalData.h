@@ -2,18 +2,41 @@
 
 #include <chrono>
 #include <Singleton.hpp>
+#include <Model.h>
 #include "../InstancedBuffer/InstancedBuffer.h"
 #include "../MappedBuffer/MappedBuffer.h"
 #include "../TextureDescriptor/TextureDescriptor.h"
 #include "../InstancedDescriptorSet/InstancedDescriptorSet.h"
 #include "../MappedDescriptorSet/MappedDescriptorSet.h"
+#include "../SlotAllocator/SlotAllocator.h"
 
 #define UNIT_PREALLOC_COUNT 500000
+#define UNIT_GROWTH_COUNT 1024
 
 #define SKELETON_BONES_BINDING          0
 #define SKELETON_OFFSET_IDS_BINDING     1
 #define SKELETON_OFFSETS_BINDING        2
 #define SKELETON_ANIMATIONS_BINDING     3
+#define SKELETON_PALETTE_BINDING        4
+#define SKELETON_PALETTE_ENTITIES_BINDING 5
+#define SKELETON_REGISTRY_BINDING       6
+
+#define NO_SKELETON                     UINT32_MAX
+
+#define VERTEX_ANIMATION_RECORDS_BINDING 0
+#define VERTEX_ANIMATION_ROWS_BINDING   1
+#define VERTEX_ANIMATION_TEXELS_BINDING 2
+
+#define NO_VERTEX_ANIMATION             UINT32_MAX
+
+#define ANIMATION_NODES_BINDING         0
+#define ANIMATION_TRACKS_BINDING        1
+#define ANIMATION_KEY_TIMES_BINDING     2
+#define ANIMATION_KEY_VALUES_BINDING    3
+
+#define SKINNING_PALETTE_CAPACITY       2048
+#define SKINNING_PALETTE_MATRIX_CAPACITY (SKINNING_PALETTE_CAPACITY * 32)
+#define ANIMATION_EVENT_CAPACITY        4096
 
 #define ENTITY_MATRIX_BINDING           0
 #define ENTITY_FRAME_BINDING            1
@@ -34,12 +57,66 @@ namespace Engine
 
         public :
 
+            /// How the bone palettes of the skeleton are produced
+            enum class SKINNING_MODE : uint32_t {
+                BAKED_PALETTE = 0,      // Every frame is baked on load, units pick a frame
+                RUNTIME_PALETTE = 1     // Compressed tracks are sampled each frame into a palette per visible unit
+            };
+
+            /// Header of the palette binding, followed by the first palette matrix of each unit
+            struct PALETTE_HEADER {
+                uint32_t count;             // Palettes used this frame, reset before each frame
+                uint32_t capacity;
+                uint32_t matrix_count;      // Matrices used this frame, reset before each frame
+                uint32_t matrix_capacity;
+                uint32_t first_matrix;      // Location of the palettes in the bones binding, in matrices
+                uint32_t padding[3];
+            };
+
+            /// Entry of the skeleton registry, matches std430 layout
+            struct SKELETON {
+                SKINNING_MODE mode;
+                uint32_t bone_count;        // Matrices in a palette
+                uint32_t first_animation;   // First frame offset of the skeleton in the animations binding
+                uint32_t first_offset_id;   // First bone in the offset ids binding
+                uint32_t fallback_palette;  // Runtime palettes : static pose shared by the units beyond the capacity, in matrices
+                uint32_t first_node;        // Runtime palettes : location of the skeleton in the animation tracks
+                uint32_t node_count;
+                uint32_t first_track;
+                uint32_t first_key;
+                uint32_t animation_count;
+                float frame_duration;
+                uint32_t padding;
+            };
+
+            /// Header of the animation events written by the culling pass
+            struct ANIMATION_EVENT_HEADER {
+                uint32_t count;         // Events appended this frame, may exceed the capacity
+                uint32_t capacity;
+                uint32_t padding[2];
+            };
+
+            /// A play once clip reached its last frame
+            struct ANIMATION_EVENT {
+                uint32_t entity_id;
+                uint32_t generation;    // Generation of the entity slot, the slot may have been released since
+                uint32_t animation_id;
+            };
+
             struct BAKED_ANIMATION {
                 uint32_t animation_id;
                 uint32_t frame_count;
                 std::chrono::milliseconds duration;
             };
 
+            /// Skeleton uploaded once and shared by every LOD group referencing its name
+            struct REGISTERED_SKELETON {
+                uint32_t id;                // Index in the registry binding
+                SKINNING_MODE mode;
+                std::map<std::string, BAKED_ANIMATION> animations;
+                std::shared_ptr<Model::FlatSkeleton> skeleton;  // Kept for the vertex animations of LOD groups
+            };
+
             InstancedBuffer instanced_buffer;
             MappedBuffer mapped_buffer;
 
@@ -51,10 +128,17 @@ namespace Engine
             InstancedDescriptorSet time_descriptor;
             InstancedDescriptorSet mouse_square_descriptor;
             InstancedDescriptorSet selection_descriptor;
+            InstancedDescriptorSet animation_event_descriptor;
+            InstancedDescriptorSet vertex_animation_descriptor;
             MappedDescriptorSet dynamic_entity_descriptor;
+            SlotAllocator dynamic_entity_slots;     // Instance ids, one record per binding of dynamic_entity_descriptor
             MappedDescriptorSet group_descriptor;
+            MappedDescriptorSet animation_tracks_descriptor;
             std::shared_ptr<Chunk> vertex_buffer;
-            std::map<std::string, BAKED_ANIMATION> animations;
+            std::map<std::string, REGISTERED_SKELETON> skeletons;
+            uint32_t runtime_node_count;    // Highest node count of the skeletons using runtime palettes
+
+            bool ReserveDynamicEntitySlots(uint32_t count);
 
         private :
 
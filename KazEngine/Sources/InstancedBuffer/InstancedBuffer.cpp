@@ -133,4 +133,15 @@ namespace Engine
         flush_range.size = VK_WHOLE_SIZE;
         vkFlushMappedMemoryRanges(Vulkan::GetDevice(), 1, &flush_range);
     }
+
+    void InstancedBuffer::Invalidate(uint8_t instance_id)
+    {
+        VkMappedMemoryRange invalidate_range;
+        invalidate_range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        invalidate_range.pNext = nullptr;
+        invalidate_range.memory = this->buffers[instance_id].memory;
+        invalidate_range.offset = 0;
+        invalidate_range.size = VK_WHOLE_SIZE;
+        vkInvalidateMappedMemoryRanges(Vulkan::GetDevice(), 1, &invalidate_range);
+    }
 }
\ No newline at end of file
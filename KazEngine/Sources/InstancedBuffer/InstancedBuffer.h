@@ -20,8 +20,10 @@ namespace Engine
             VkDescriptorBufferInfo GetBufferInfos(uint8_t instance_id = 0) const { return {this->buffers[instance_id].handle, 0, this->buffers[instance_id].size}; }
             void WriteData(const void* data, VkDeviceSize data_size, VkDeviceSize global_offset) { for(uint8_t i=0; i<this->instance_count; i++) this->WriteData(data, data_size, global_offset, i); }
             void WriteData(const void* data, VkDeviceSize data_size, VkDeviceSize global_offset, uint8_t instance_id);
+            void ReadData(void* data, VkDeviceSize data_size, VkDeviceSize global_offset, uint8_t instance_id) const { std::memcpy(data, this->buffers[instance_id].pointer + global_offset, data_size); }
             vk::MAPPED_BUFFER const& GetBuffer(uint8_t instance_id = 0) const { return this->buffers[instance_id]; }
             void Flush(uint8_t instance_id = 0);
+            void Invalidate(uint8_t instance_id = 0);
             void MoveData(size_t source_offset, size_t dest_offset, size_t size) { for(uint8_t i=0; i<this->buffers.size(); i++) std::memcpy(this->buffers[i].pointer + dest_offset, this->buffers[i].pointer + source_offset, size); }
             
         private :
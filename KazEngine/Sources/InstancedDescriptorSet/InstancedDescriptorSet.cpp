@@ -49,6 +49,11 @@ namespace Engine
         GlobalData::GetInstance()->instanced_buffer.WriteData(data, size, this->bindings[binding].chunk->offset + offset, instance_id);
     }
 
+    void InstancedDescriptorSet::ReadData(void* data, VkDeviceSize size, size_t offset, uint8_t binding, uint8_t instance_id) const
+    {
+        GlobalData::GetInstance()->instanced_buffer.ReadData(data, size, this->bindings[binding].chunk->offset + offset, instance_id);
+    }
+
     VkDescriptorSetLayoutBinding InstancedDescriptorSet::CreateSimpleBinding(uint32_t binding, VkDescriptorType type, VkShaderStageFlags stage_flags)
     {
         VkDescriptorSetLayoutBinding layout_binding;
@@ -30,8 +30,11 @@ namespace Engine
             std::shared_ptr<Chunk> ReserveRange(size_t size, uint8_t binding = 0);
             void WriteData(const void* data, VkDeviceSize size, size_t offset, uint8_t binding, uint8_t instance_id);
             void WriteData(const void* data, VkDeviceSize size, size_t offset, uint8_t binding = 0) { for(uint8_t i=0; i<this->sets.size(); i++) { this->WriteData(data, size, offset, binding, i); } }
+            void ReadData(void* data, VkDeviceSize size, size_t offset, uint8_t binding, uint8_t instance_id) const;
             bool Update(uint8_t instance_id);
 
+            void FreeChunk(std::shared_ptr<Chunk> chunk, uint8_t binding = 0) { this->bindings[binding].chunk->FreeChild(chunk); }
+
         private :
 
             struct DESCRIPTOR_SET_BINDING {
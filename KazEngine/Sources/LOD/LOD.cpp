@@ -18,7 +18,14 @@ namespace Engine
     LODGroup::LODGroup()
     {
         this->texture_id = -1;
+        this->skeleton_id = NO_SKELETON;
+        this->vertex_animation_level = MAX_LOD_COUNT;
         this->hit_box = nullptr;
+        this->index_buffer_offset = 0;
+        this->index_type = VK_INDEX_TYPE_UINT16;
+        this->vertex_format = Model::CookedMesh::FLOAT_VERTEX;
+        this->dequantization = {};
+        this->max_influences = Model::Deformer::MAX_BONES_PER_VERTEX;
     }
 
     LODGroup::~LODGroup()
@@ -55,64 +62,132 @@ namespace Engine
             return false;
         }
 
-        // Set LOD chunk
-        uint32_t first_vertex = 0;
-        float lod_distances[] = {0.0f, 15.0f, 40.0f, 100.0f};
-        for(uint8_t i=0; i<MAX_LOD_COUNT; i++) {
+        // Meshes added with AddLOD are indexed on the fly, the vertex cache pass is left to packaging
+        std::shared_ptr<Model::CookedMesh> cooked_mesh = this->cooked_mesh;
+        if(cooked_mesh == nullptr) {
+            uint32_t cooked_size;
+            std::unique_ptr<char> cooked_data = Model::CookedMesh::Cook(this->lods, cooked_size, this->vertex_format, nullptr, false);
+            cooked_mesh = std::shared_ptr<Model::CookedMesh>(new Model::CookedMesh);
+            if(cooked_data == nullptr || !cooked_mesh->Deserialize(std::vector<char>(cooked_data.get(), cooked_data.get() + cooked_size))) {
+                #if defined(DISPLAY_LOGS)
+                std::cout << "LODGroup::Build() : Invalid meshes" << std::endl;
+                #endif
+                return false;
+            }
+        }
 
-            if(i >= this->lods.size()) {
-                LOD lod = {};
-                GlobalData::GetInstance()->lod_descriptor.WriteData(&lod, sizeof(LOD), this->lod_chunk->offset + i * sizeof(LOD));
+        uint32_t index_size = cooked_mesh->GetIndexSize();
+        if(cooked_mesh->lods.size() > MAX_LOD_COUNT || (index_size != sizeof(uint16_t) && index_size != sizeof(uint32_t))) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "LODGroup::Build() : Unsupported mesh, too many LODs or unknown index size" << std::endl;
+            #endif
+            return false;
+        }
 
-            }else{
-                LOD lod;
-                lod.first_vertex = first_vertex;
-                lod.vertex_count = static_cast<uint32_t>(this->lods[i]->index_buffer.size());
-                lod.valid = 1;
-                if(!lod.vertex_count) lod.vertex_count = static_cast<uint32_t>(this->lods[i]->vertex_buffer.size());
-                lod.distance = lod_distances[i];
-                first_vertex += lod.vertex_count;
+        // Compact vertices may have been refused by the cooker
+        this->vertex_format = cooked_mesh->GetVertexFormat();
+        this->dequantization = cooked_mesh->GetDequantization();
+        this->max_influences = cooked_mesh->GetMaxInfluences();
+
+        this->index_type = index_size == sizeof(uint32_t) ? VK_INDEX_TYPE_UINT32 : VK_INDEX_TYPE_UINT16;
+
+        // Vertices, then indices aligned on their size, padded to keep the next group aligned for vertex attributes
+        this->index_buffer_offset = (cooked_mesh->GetVertexDataSize() + index_size - 1) / index_size * index_size;
+        VkDeviceSize total_size = this->index_buffer_offset + cooked_mesh->GetIndexDataSize();
+        total_size = (total_size + sizeof(uint32_t) - 1) / sizeof(uint32_t) * sizeof(uint32_t);
+        if(!this->AllocateVertexBuffer(total_size)) return false;
+
+        // Far LODs skip skinning, their positions are baked for every frame
+        std::unique_ptr<Model::VertexAnimationBaker> vertex_animation_baker;
+        if(this->vertex_animation_level < cooked_mesh->lods.size()) {
+            auto registered = GlobalData::GetInstance()->skeletons.find(this->GetSkeleton());
+            if(registered != GlobalData::GetInstance()->skeletons.end() && registered->second.skeleton != nullptr)
+                vertex_animation_baker = std::unique_ptr<Model::VertexAnimationBaker>(new Model::VertexAnimationBaker(*registered->second.skeleton, 30));
+        }
 
-                GlobalData::GetInstance()->lod_descriptor.WriteData(&lod, sizeof(LOD), this->lod_chunk->offset + i * sizeof(LOD));
+        // Vertex and index buffers are bound at the start of the group, values are relative to it
+        // Set LOD chunk
+        float lod_distances[] = {0.0f, 15.0f, 40.0f, 100.0f, 100.0f};
+        for(uint8_t i=0; i<MAX_LOD_COUNT; i++) {
+            LOD lod = {};
+            lod.skeleton_id = this->skeleton_id;
+            lod.vertex_animation = NO_VERTEX_ANIMATION;
+            if(i < cooked_mesh->lods.size()) {
+                lod.first_index = cooked_mesh->lods[i].first_index;
+                lod.index_count = cooked_mesh->lods[i].index_count;
+                lod.vertex_offset = static_cast<int32_t>(cooked_mesh->lods[i].first_vertex);
+                lod.distance = lod_distances[i];
+                lod.valid = 1;
+                if(vertex_animation_baker != nullptr && i >= this->vertex_animation_level)
+                    lod.vertex_animation = this->BuildVertexAnimation(*vertex_animation_baker, *cooked_mesh, i);
             }
+            GlobalData::GetInstance()->lod_descriptor.WriteData(&lod, sizeof(LOD), this->lod_chunk->offset + i * sizeof(LOD));
         }
 
-        // Compute vertex buffer size
-        VkDeviceSize total_vbo_size = 0;
-        std::vector<std::pair<std::unique_ptr<char>, size_t>> vbos;
-        for(uint8_t i=0; i<this->lods.size(); i++) {
-            
-            VkDeviceSize vbo_size, index_buffer_offset;
-            std::unique_ptr<char> mesh_vbo = this->lods[i]->BuildVBO(vbo_size, index_buffer_offset);
-            total_vbo_size += vbo_size;
-            vbos.push_back({std::move(mesh_vbo), vbo_size});
-        }
+        // Single copy of every LOD
+        GlobalData::GetInstance()->instanced_buffer.WriteData(cooked_mesh->GetVertexData(), cooked_mesh->GetVertexDataSize(), this->GetVertexBufferOffset());
+        GlobalData::GetInstance()->instanced_buffer.WriteData(cooked_mesh->GetIndexData(), cooked_mesh->GetIndexDataSize(), this->GetIndexBufferOffset());
+
+        return true;
+    }
 
-        // Allocate vertex buffer
+    bool LODGroup::AllocateVertexBuffer(VkDeviceSize size)
+    {
         bool relocated;
         if(!GlobalData::GetInstance()->instanced_buffer.GetChunk()->ResizeChild(
                     GlobalData::GetInstance()->vertex_buffer,
-                    GlobalData::GetInstance()->vertex_buffer->range + total_vbo_size,
+                    GlobalData::GetInstance()->vertex_buffer->range + size,
                     relocated)) {
             #if defined(DISPLAY_LOGS)
             std::cout << "LODGroup::Build() : Not enough memory" << std::endl;
             #endif
             return false;
         }
-        this->vertex_buffer_chunk = GlobalData::GetInstance()->vertex_buffer->ReserveRange(total_vbo_size);
+        this->vertex_buffer_chunk = GlobalData::GetInstance()->vertex_buffer->ReserveRange(size);
 
-        // Write vertex buffer
-        size_t lod_offset = 0;
-        for(uint8_t i=0; i<vbos.size(); i++) {
+        return true;
+    }
 
-            GlobalData::GetInstance()->instanced_buffer.WriteData(
-                vbos[i].first.get(), vbos[i].second,
-                GlobalData::GetInstance()->vertex_buffer->offset + this->vertex_buffer_chunk->offset + lod_offset
-            );
-            lod_offset += vbos[i].second;
+    /**
+     * Upload the vertex animation texture of a LOD
+     * @param baker Bone palettes of the skeleton
+     * @param cooked_mesh Vertices of the group
+     * @param level LOD level
+     * @return Index of the vertex animation, NO_VERTEX_ANIMATION if the LOD is skinned as usual
+     */
+    uint32_t LODGroup::BuildVertexAnimation(Model::VertexAnimationBaker const& baker, Model::CookedMesh const& cooked_mesh, uint8_t level)
+    {
+        Model::VertexAnimationBaker::TEXTURE texture;
+        if(!baker.Bake(cooked_mesh, level, texture)) return NO_VERTEX_ANIMATION;
+
+        InstancedDescriptorSet& descriptor = GlobalData::GetInstance()->vertex_animation_descriptor;
+        auto record_chunk = descriptor.ReserveRange(sizeof(VERTEX_ANIMATION), VERTEX_ANIMATION_RECORDS_BINDING);
+        auto rows_chunk = descriptor.ReserveRange(texture.first_rows.size() * sizeof(uint32_t), VERTEX_ANIMATION_ROWS_BINDING);
+        auto texels_chunk = descriptor.ReserveRange(texture.texels.size() * sizeof(Model::VertexAnimationBaker::TEXEL), VERTEX_ANIMATION_TEXELS_BINDING);
+        if(record_chunk == nullptr || rows_chunk == nullptr || texels_chunk == nullptr) {
+            #if defined(DISPLAY_LOGS)
+            std::cout << "LODGroup::Build() : Not enough memory for vertex animation" << std::endl;
+            #endif
+            return NO_VERTEX_ANIMATION;
         }
 
-        return true;
+        // First texel of each animation, from the start of the texels binding
+        uint32_t first_texel = static_cast<uint32_t>(texels_chunk->offset / sizeof(Model::VertexAnimationBaker::TEXEL));
+        std::vector<uint32_t> rows(texture.first_rows.size());
+        for(size_t i=0; i<rows.size(); i++) rows[i] = first_texel + texture.first_rows[i] * texture.vertex_count;
+
+        VERTEX_ANIMATION vertex_animation = {};
+        vertex_animation.first_animation = static_cast<uint32_t>(rows_chunk->offset / sizeof(uint32_t));
+        vertex_animation.first_vertex = cooked_mesh.lods[level].first_vertex;
+        vertex_animation.vertex_count = texture.vertex_count;
+        vertex_animation.position_offset = texture.position_offset;
+        vertex_animation.position_scale = texture.position_scale;
+
+        descriptor.WriteData(&vertex_animation, sizeof(VERTEX_ANIMATION), record_chunk->offset, VERTEX_ANIMATION_RECORDS_BINDING);
+        descriptor.WriteData(rows.data(), rows.size() * sizeof(uint32_t), rows_chunk->offset, VERTEX_ANIMATION_ROWS_BINDING);
+        descriptor.WriteData(texture.texels.data(), texture.texels.size() * sizeof(Model::VertexAnimationBaker::TEXEL), texels_chunk->offset, VERTEX_ANIMATION_TEXELS_BINDING);
+
+        return static_cast<uint32_t>(record_chunk->offset / sizeof(VERTEX_ANIMATION));
     }
 
     //void LODGroup::Render(VkCommandBuffer command_buffer, uint32_t instance_id, VkPipelineLayout layout, uint32_t instance_count,
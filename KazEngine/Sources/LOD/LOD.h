@@ -12,16 +12,31 @@ namespace Engine
         public :
 
             struct LOD {
-                uint32_t first_vertex;
-			    uint32_t vertex_count;
-			    float distance;
-			    uint32_t valid;
+                uint32_t first_index;
+                uint32_t index_count;
+                int32_t vertex_offset;
+                float distance;
+                uint32_t valid;
+                uint32_t skeleton_id;       // Entry of the skeleton registry, NO_SKELETON for rigid meshes
+                uint32_t vertex_animation;  // Baked skinned positions, NO_VERTEX_ANIMATION to skin with the bone palettes
+                uint32_t padding;
+            };
+
+            /// Vertex animation texture of a LOD, matches std430 layout
+            struct VERTEX_ANIMATION {
+                uint32_t first_animation;   // First row offset in the rows binding
+                uint32_t first_vertex;      // Vertex of the LOD stored in the first column
+                uint32_t vertex_count;      // Texels per row
+                uint32_t padding;
+                Maths::Vector4 position_offset;
+                Maths::Vector4 position_scale;
             };
 
             struct INDIRECT_COMMAND {
-                uint32_t vertexCount;
+                uint32_t indexCount;
                 uint32_t instanceCount;
-                uint32_t firstVertex;
+                uint32_t firstIndex;
+                int32_t vertexOffset;
                 uint32_t firstInstance;
                 uint32_t lodIndex;
             };
@@ -34,6 +49,12 @@ namespace Engine
                 int32_t texture_id;
             };
 
+            /// Pushed before each run of draws sharing the group
+            struct PUSH_CONSTANT_DRAW {
+                Model::CookedMesh::DEQUANTIZATION dequantization;
+                uint32_t skeleton_id;
+            };
+
             struct HIT_BOX {
                 Maths::Vector3 near_left_bottom_point;
                 Maths::Vector3 far_right_top_point;
@@ -42,9 +63,15 @@ namespace Engine
             LODGroup();
             ~LODGroup();
             void AddLOD(std::shared_ptr<Model::Mesh> lod, uint8_t level);
+            void SetCookedMesh(std::shared_ptr<Model::CookedMesh> cooked_mesh) { this->cooked_mesh = cooked_mesh; }
+            void SetVertexFormat(Model::CookedMesh::VERTEX_FORMAT format) { this->vertex_format = format; }
+            Model::CookedMesh::VERTEX_FORMAT GetVertexFormat() const { return this->vertex_format; }
+            Model::CookedMesh::DEQUANTIZATION const& GetDequantization() const { return this->dequantization; }
+            /// Highest number of bones influencing a vertex of any LOD, known once built
+            uint8_t GetMaxInfluences() const { return this->max_influences; }
             bool Build();
-            std::string const GetSkeleton() const { for(auto lod : this->lods) if(!lod->skeleton.empty()) return lod->skeleton; return {}; }
-            std::string const GetTexture() const { for(auto lod : this->lods) if(!lod->texture.empty()) return lod->texture; return {}; }
+            std::string const GetSkeleton() const { if(this->cooked_mesh != nullptr) return this->cooked_mesh->skeleton; for(auto lod : this->lods) if(!lod->skeleton.empty()) return lod->skeleton; return {}; }
+            std::string const GetTexture() const { if(this->cooked_mesh != nullptr) return this->cooked_mesh->texture; for(auto lod : this->lods) if(!lod->texture.empty()) return lod->texture; return {}; }
             std::shared_ptr<Model::Mesh> GetLOD(uint8_t level = 0) const { return this->lods[level]; }
             void SetHitBox(HIT_BOX hit_box) { if(this->hit_box == nullptr) this->hit_box = new HIT_BOX; *this->hit_box = hit_box; }
             HIT_BOX* GetHitBox() const { return this->hit_box; }
@@ -52,7 +79,13 @@ namespace Engine
             /*void Render(VkCommandBuffer command_buffer, uint32_t instance_id, VkPipelineLayout layout, uint32_t instance_count,
                         std::vector<std::pair<bool, std::shared_ptr<Chunk>>> instance_buffer_chunks, size_t indirect_offset, VkBuffer buffer) const;*/
             void SetTextureID(int32_t id) { this->texture_id = id; }
-            // size_t GetVertexBufferOffset() { return this->vertex_buffer_chunk->offset; }
+            void SetSkeletonID(uint32_t id) { this->skeleton_id = id; }
+            /// LODs from first_level are drawn from baked skinned positions of the registered skeleton
+            void SetVertexAnimation(uint8_t first_level) { this->vertex_animation_level = first_level; }
+            uint32_t GetSkeletonID() const { return this->skeleton_id; }
+            VkDeviceSize GetVertexBufferOffset() const { return GlobalData::GetInstance()->vertex_buffer->offset + this->vertex_buffer_chunk->offset; }
+            VkDeviceSize GetIndexBufferOffset() const { return this->GetVertexBufferOffset() + this->index_buffer_offset; }
+            VkIndexType GetIndexType() const { return this->index_type; }
 
             // static bool Initialize();
             // static void Clear();
@@ -63,8 +96,19 @@ namespace Engine
             std::shared_ptr<Chunk> lod_chunk;
             // std::shared_ptr<Chunk> vertex_buffer;
             std::vector<std::shared_ptr<Model::Mesh>> lods;
+            std::shared_ptr<Model::CookedMesh> cooked_mesh;
             std::shared_ptr<Chunk> vertex_buffer_chunk;
+            VkDeviceSize index_buffer_offset;
+            VkIndexType index_type;         // 32 bits once a LOD has more than 65536 unique vertices
+            Model::CookedMesh::VERTEX_FORMAT vertex_format;
+            Model::CookedMesh::DEQUANTIZATION dequantization;
+            uint8_t max_influences;
             int32_t texture_id;
+            uint32_t skeleton_id;
+            uint8_t vertex_animation_level;
             HIT_BOX* hit_box;
+
+            bool AllocateVertexBuffer(VkDeviceSize size);
+            uint32_t BuildVertexAnimation(Model::VertexAnimationBaker const& baker, Model::CookedMesh const& cooked_mesh, uint8_t level);
     };
 }
\ No newline at end of file
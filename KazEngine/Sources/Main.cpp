@@ -36,25 +36,32 @@ int main(int argc, char** argv)
     std::cout << "Engine initialization : Success" << std::endl;
     #endif
 
-    auto data_buffer = Tools::GetBinaryFileContents("data.kea");
-    auto guy_texture = Model::Loader::GetImageFromPackage(data_buffer, "/SimpleGuy/SimpleGuy.2.0.png");
-    auto grass_texture = Model::Loader::GetImageFromPackage(data_buffer, "/grass_tile2");
-    engine->LoadTexture(guy_texture, "SimpleGuy.2.0.png");
-    engine->LoadTexture(grass_texture, "grass_tile2");
-    auto skeleton = Model::Loader::GetSkeletonFromPackage(data_buffer, "/SimpleGuy/Armature");
-    engine->LoadSkeleton(skeleton);
-    auto mesh_lod0 = Model::Loader::GetMeshFromPackage(data_buffer, "/SimpleGuy/Body_LOD0");
-    auto mesh_lod1 = Model::Loader::GetMeshFromPackage(data_buffer, "/SimpleGuy/Body_LOD1");
-    auto mesh_lod2 = Model::Loader::GetMeshFromPackage(data_buffer, "/SimpleGuy/Body_LOD2");
-    auto mesh_lod3 = Model::Loader::GetMeshFromPackage(data_buffer, "/SimpleGuy/Body_LOD3");
-
+    DataPacker::MappedPackage package("data.kea");
     Engine::LODGroup simple_guy_lod;
-    simple_guy_lod.AddLOD(mesh_lod0, 0);
-    simple_guy_lod.AddLOD(mesh_lod1, 1);
-    simple_guy_lod.AddLOD(mesh_lod2, 2);
-    simple_guy_lod.AddLOD(mesh_lod3, 3);
-    simple_guy_lod.SetHitBox({{-0.25f, 0.0f, 0.25f},{0.25f, -1.3f, -0.25f}});
-    engine->LoadModel(simple_guy_lod);
+    {
+        // Every item is decoded in background, GPU uploads stay on this thread
+        Model::AsyncLoader loader(package);
+        auto guy_texture = loader.RequestImage("/SimpleGuy/SimpleGuy.2.0.png");
+        auto grass_texture = loader.RequestImage("/grass_tile2");
+        auto skeleton = loader.RequestSkeleton("/SimpleGuy/Armature");
+
+        // Cooked vertex buffer is preferred, separate LOD meshes are the fallback
+        std::shared_future<std::shared_ptr<Model::CookedMesh>> cooked_mesh;
+        std::vector<std::shared_future<std::shared_ptr<Model::Mesh>>> meshes;
+        if(package.Index().Find("/SimpleGuy/cooked") != nullptr) cooked_mesh = loader.RequestCookedMesh("/SimpleGuy/cooked");
+        else meshes = loader.RequestMeshes({"/SimpleGuy/Body_LOD0", "/SimpleGuy/Body_LOD1", "/SimpleGuy/Body_LOD2", "/SimpleGuy/Body_LOD3"});
+
+        engine->LoadTexture(guy_texture.get(), "SimpleGuy.2.0.png");
+        engine->LoadTexture(grass_texture.get(), "grass_tile2");
+        engine->LoadSkeleton(skeleton.get());
+
+        if(cooked_mesh.valid()) simple_guy_lod.SetCookedMesh(cooked_mesh.get());
+        for(uint8_t i=0; i<meshes.size(); i++) simple_guy_lod.AddLOD(meshes[i].get(), i);
+        simple_guy_lod.SetHitBox({{-0.25f, 0.0f, 0.25f},{0.25f, -1.3f, -0.25f}});
+        simple_guy_lod.SetVertexAnimation(2);
+        engine->LoadModel(simple_guy_lod);
+    }
+    // The cooked mesh points into the mapped file, the package stays open until the renderer is destroyed
 
     std::vector<std::shared_ptr<Engine::DynamicEntity>> entities;
 
@@ -115,7 +122,7 @@ int main(int argc, char** argv)
 
                 std::shared_ptr<Engine::DynamicEntity> entity = std::shared_ptr<Engine::DynamicEntity>(new Engine::DynamicEntity);
                 entity->AddModel(&simple_guy_lod);
-                engine->AddToScene(*entity);
+                if(!engine->AddToScene(*entity)) break;
 
                 entities.resize(entities.size() + 1);
                 entities[entities.size()-1] = entity;
@@ -157,6 +164,7 @@ int main(int argc, char** argv)
     }
 
     engine->DestroyInstance();
+    package.Close();
     vulkan->DestroyInstance();
     delete main_window;
 
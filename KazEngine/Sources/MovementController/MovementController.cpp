@@ -122,9 +122,7 @@ namespace Engine
             if(group_check.inside_count >= group_check.unit_count) {
                 group_check.unit_count = 0;
             }else{
-                uint32_t max_count = 1;
-		        for(int i=1; i<group_check.scale; i++) max_count += i * 6;
-                if(group_check.inside_count >= max_count) group_check.scale++;
+                if(group_check.inside_count >= Maths::hexagon_cell_count(group_check.scale)) group_check.scale++;
             }
 
             group_check.fill_count = 0;
@@ -0,0 +1,69 @@
+#include "SlotAllocator.h"
+
+namespace Engine
+{
+    /**
+     * Forget every slot and set the maximum number of live records
+     * @param capacity Number of records preallocated in the bindings
+     */
+    void SlotAllocator::Reset(uint32_t capacity)
+    {
+        this->capacity = capacity;
+        this->count = 0;
+        this->used.clear();
+        this->generations.clear();
+        this->free_slots.clear();
+        this->used.reserve(capacity);
+        this->generations.reserve(capacity);
+        this->free_slots.reserve(capacity);
+    }
+
+    /**
+     * Raise the capacity once the bindings have been extended, existing slots are kept
+     * @param count Number of records added at the end of the bindings
+     */
+    void SlotAllocator::Grow(uint32_t count)
+    {
+        this->capacity += count;
+        this->used.reserve(this->capacity);
+        this->generations.reserve(this->capacity);
+        this->free_slots.reserve(this->capacity);
+    }
+
+    /**
+     * Hand out a slot, reusing the last released one if any
+     * @retval Slot with index UINT32_MAX when the allocator is full
+     */
+    SlotAllocator::SLOT SlotAllocator::Allocate()
+    {
+        uint32_t index;
+        if(!this->free_slots.empty()) {
+            index = this->free_slots.back();
+            this->free_slots.pop_back();
+        }else{
+            if(this->used.size() >= this->capacity) return {UINT32_MAX, 0};
+            index = static_cast<uint32_t>(this->used.size());
+            this->used.push_back(0);
+            this->generations.push_back(0);
+        }
+
+        this->used[index] = 1;
+        this->count++;
+        return {index, this->generations[index]};
+    }
+
+    /**
+     * Release a slot, its index may be handed out again by the next allocation
+     * @retval false if the slot is not in use or was released since the handle was given
+     */
+    bool SlotAllocator::Free(SLOT const& slot)
+    {
+        if(!this->IsUsed(slot)) return false;
+
+        this->used[slot.index] = 0;
+        this->generations[slot.index]++;
+        this->free_slots.push_back(slot.index);
+        this->count--;
+        return true;
+    }
+}
\ No newline at end of file
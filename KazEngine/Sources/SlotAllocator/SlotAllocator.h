@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+namespace Engine
+{
+    /**
+     * Allocator of fixed-stride records : a slot index addresses the same record in every binding sized for the capacity.
+     * Freed slots are reused first, allocation and release are O(1) and never move a record.
+     * Each release increments the generation of the slot, a handle kept after its release no longer matches.
+     */
+    class SlotAllocator
+    {
+        public :
+
+            struct SLOT {
+                uint32_t index;
+                uint32_t generation;
+            };
+
+            inline SlotAllocator() : capacity(0), count(0) {}
+            void Reset(uint32_t capacity);
+            void Grow(uint32_t count);
+            SLOT Allocate();
+            bool Free(SLOT const& slot);
+            inline bool IsUsed(SLOT const& slot) const { return slot.index < this->used.size() && this->used[slot.index] && this->generations[slot.index] == slot.generation; }
+            inline uint32_t GetCount() const { return this->count; }
+            inline uint32_t GetCapacity() const { return this->capacity; }
+            inline uint32_t GetUpperBound() const { return static_cast<uint32_t>(this->used.size()); }
+
+        private :
+
+            uint32_t capacity;
+            uint32_t count;
+            std::vector<uint8_t> used;              // One flag for every slot handed out at least once
+            std::vector<uint32_t> generations;      // Incremented on each release of the slot
+            std::vector<uint32_t> free_slots;       // Released indices, the last one released is reused first
+    };
+}
@@ -819,6 +819,31 @@ namespace Engine { namespace vk
                         offset += sizeof(uint32_t);
                         break;
 
+                    case VERTEX_BINDING_ATTRIBUTE::FLOAT_VALUE :
+                        attribute.format = VK_FORMAT_R32_SFLOAT;
+                        offset += sizeof(float);
+                        break;
+
+                    case VERTEX_BINDING_ATTRIBUTE::POSITION_UNORM16 :
+                        attribute.format = VK_FORMAT_R16G16B16A16_UNORM;
+                        offset += sizeof(uint16_t) * 4;
+                        break;
+
+                    case VERTEX_BINDING_ATTRIBUTE::UV_UNORM16 :
+                        attribute.format = VK_FORMAT_R16G16_UNORM;
+                        offset += sizeof(uint16_t) * 2;
+                        break;
+
+                    case VERTEX_BINDING_ATTRIBUTE::BONE_WEIGHTS_UNORM8 :
+                        attribute.format = VK_FORMAT_R8G8B8A8_UNORM;
+                        offset += sizeof(uint8_t) * 4;
+                        break;
+
+                    case VERTEX_BINDING_ATTRIBUTE::BONE_IDS_UINT8 :
+                        attribute.format = VK_FORMAT_R8G8B8A8_UINT;
+                        offset += sizeof(uint8_t) * 4;
+                        break;
+
                     default :
                         attribute.format = VK_FORMAT_UNDEFINED;
                 }
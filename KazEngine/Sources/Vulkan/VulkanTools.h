@@ -56,7 +56,12 @@ namespace Engine { namespace vk
         BONE_IDS        = 5,
         POSITION_2D     = 6,
         MATRIX          = 7,
-        UINT_ID         = 8
+        UINT_ID         = 8,
+        POSITION_UNORM16        = 9,
+        UV_UNORM16              = 10,
+        BONE_WEIGHTS_UNORM8     = 11,
+        BONE_IDS_UINT8          = 12,
+        FLOAT_VALUE             = 13
     };
 
     IMAGE_BUFFER CreateImageBuffer(VkImageUsageFlags usage, VkImageAspectFlags aspect, uint32_t width, uint32_t height, VkFormat format = VK_FORMAT_R8G8B8A8_UNORM);
@@ -6,28 +6,33 @@ CALL :COMPILE map.frag
 CALL :COMPILE textured_model.vert
 CALL :COMPILE textured_model.frag
 CALL :COMPILE dynamic_model.vert
+CALL :COMPILE dynamic_model.vert dynamic_model_compact.vert -DCOMPACT_VERTEX
 CALL :COMPILE interface.vert
 CALL :COMPILE interface.frag
 CALL :COMPILE cross.vert
 CALL :COMPILE cross.frag
 CALL :COMPILE cull_lod.comp
 CALL :COMPILE cull_lod_anim.comp
+CALL :COMPILE animate_palette.comp
 CALL :COMPILE move_collision.comp
 CALL :COMPILE move_groups.comp
 pause
 
 :COMPILE
-DEL %CD%\Shaders\%~1.spv 2>NUL
-DEL %CD%\x64\Debug\Shaders\%~1.spv 2>NUL
-DEL %CD%\x64\Release\Shaders\%~1.spv 2>NUL
+REM %~1 : source, %~2 : optional output name when the source is compiled with the defines %~3
+SET OUTPUT=%~1
+IF NOT "%~2"=="" SET OUTPUT=%~2
+DEL %CD%\Shaders\%OUTPUT%.spv 2>NUL
+DEL %CD%\x64\Debug\Shaders\%OUTPUT%.spv 2>NUL
+DEL %CD%\x64\Release\Shaders\%OUTPUT%.spv 2>NUL
 
-%VK_SDK_PATH%\bin\glslangvalidator -V %CD%\Shaders\%~1 -o %CD%\Shaders\%~1.spv 1>NUL
+%VK_SDK_PATH%\bin\glslangvalidator -V %~3 %CD%\Shaders\%~1 -o %CD%\Shaders\%OUTPUT%.spv 1>NUL
 IF %ERRORLEVEL% NEQ 0 (
-	ECHO %~1 : FAILED
-	%VK_SDK_PATH%\bin\glslangvalidator -V %CD%\Shaders\%~1 -o %CD%\Shaders\%~1.spv
+	ECHO %OUTPUT% : FAILED
+	%VK_SDK_PATH%\bin\glslangvalidator -V %~3 %CD%\Shaders\%~1 -o %CD%\Shaders\%OUTPUT%.spv
 ) else (
-	ECHO %~1 : OK
-	xcopy %CD%\Shaders\%~1.spv %CD%\..\x64\Debug\Shaders\ /Y /Q 1>NUL
-	xcopy %CD%\Shaders\%~1.spv %CD%\..\x64\Release\Shaders\ /Y /Q 1>NUL
+	ECHO %OUTPUT% : OK
+	xcopy %CD%\Shaders\%OUTPUT%.spv %CD%\..\x64\Debug\Shaders\ /Y /Q 1>NUL
+	xcopy %CD%\Shaders\%OUTPUT%.spv %CD%\..\x64\Release\Shaders\ /Y /Q 1>NUL
 )
 EXIT /B 0
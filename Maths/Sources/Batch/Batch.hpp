@@ -0,0 +1,212 @@
+#pragma once
+
+#include <vector>
+#include <cstring>
+#include "../Matrix/Matrix.hpp"
+#include "../Others/Others.hpp"
+
+namespace Maths
+{
+    /**
+     * Kernels working on many points or boxes at once, stored component by component (structure of arrays).
+     * Four items are processed per iteration with the SIMD backend, the remainder goes through the scalar functions.
+     */
+    namespace Batch
+    {
+        /// Point list, one array per axis
+        struct POINTS {
+            std::vector<float> x;
+            std::vector<float> y;
+            std::vector<float> z;
+
+            inline size_t Size() const { return this->x.size(); }
+            inline void Resize(size_t count) { this->x.resize(count); this->y.resize(count); this->z.resize(count); }
+            inline void Set(size_t index, Vector3 const& point) { this->x[index] = point.x; this->y[index] = point.y; this->z[index] = point.z; }
+            inline Vector3 Get(size_t index) const { return {this->x[index], this->y[index], this->z[index]}; }
+        };
+
+        /// Hit-box list, same layout as the scalar functions : near-bottom-left and far-top-right corners
+        struct BOXES {
+            POINTS min;
+            POINTS max;
+
+            inline size_t Size() const { return this->min.Size(); }
+            inline void Resize(size_t count) { this->min.Resize(count); this->max.Resize(count); }
+        };
+
+        #if defined(MATHS_SIMD)
+        /// Write the 4 bits of a comparison mask as 4 bytes holding 0 or 1
+        inline void ExpandMask(uint8_t mask, uint8_t* output)
+        {
+            static const uint8_t expanded[16][4] = {
+                {0,0,0,0}, {1,0,0,0}, {0,1,0,0}, {1,1,0,0}, {0,0,1,0}, {1,0,1,0}, {0,1,1,0}, {1,1,1,0},
+                {0,0,0,1}, {1,0,0,1}, {0,1,0,1}, {1,1,0,1}, {0,0,1,1}, {1,0,1,1}, {0,1,1,1}, {1,1,1,1}
+            };
+            std::memcpy(output, expanded[mask], 4);
+        }
+
+        /// Same column of 4 matrices, transposed : one register per matrix value of the 3 first rows, one lane per matrix
+        inline void LoadTransposed(Matrix4x4 const* const* matrices, Simd::FLOAT4 (&values)[4][3])
+        {
+            for(uint8_t column=0; column<4; column++) {
+                Simd::FLOAT4 a = Simd::LoadUnaligned(matrices[0]->Data() + column * 4);
+                Simd::FLOAT4 b = Simd::LoadUnaligned(matrices[1]->Data() + column * 4);
+                Simd::FLOAT4 c = Simd::LoadUnaligned(matrices[2]->Data() + column * 4);
+                Simd::FLOAT4 d = Simd::LoadUnaligned(matrices[3]->Data() + column * 4);
+                Simd::Transpose(a, b, c, d);
+                values[column][0] = a;
+                values[column][1] = b;
+                values[column][2] = c;
+            }
+        }
+
+        /// Transform 4 points loaded from index of the input
+        inline void TransformTransposed(Simd::FLOAT4 const (&values)[4][3], POINTS const& points, size_t index, POINTS& output)
+        {
+            Simd::FLOAT4 x = Simd::LoadUnaligned(points.x.data() + index);
+            Simd::FLOAT4 y = Simd::LoadUnaligned(points.y.data() + index);
+            Simd::FLOAT4 z = Simd::LoadUnaligned(points.z.data() + index);
+
+            float* outputs[3] = {output.x.data() + index, output.y.data() + index, output.z.data() + index};
+            for(uint8_t row=0; row<3; row++) {
+                Simd::FLOAT4 result = Simd::MulAdd(values[0][row], x, values[3][row]);
+                result = Simd::MulAdd(values[1][row], y, result);
+                Simd::StoreUnaligned(outputs[row], Simd::MulAdd(values[2][row], z, result));
+            }
+        }
+        #endif
+
+        /**
+         * Transform each point by its own matrix, same result as Vector3(*matrices[i] * point)
+         * @param matrices One matrix per point
+         * @param points Input points
+         * @param[out] output Transformed points, resized to the input size
+         */
+        inline void TransformPoints(Matrix4x4 const* const* matrices, POINTS const& points, POINTS& output)
+        {
+            size_t count = points.Size();
+            output.Resize(count);
+
+            size_t i = 0;
+            #if defined(MATHS_SIMD)
+            for(; i + 4 <= count; i += 4) {
+                Simd::FLOAT4 values[4][3];
+                Batch::LoadTransposed(matrices + i, values);
+                Batch::TransformTransposed(values, points, i, output);
+            }
+            #endif
+
+            for(; i<count; i++) output.Set(i, *matrices[i] * points.Get(i));
+        }
+
+        /**
+         * Transform both corners of each hit-box by its own matrix, matrices are read once
+         * @param matrices One matrix per box
+         * @param boxes Input boxes
+         * @param[out] output Transformed corners, resized to the input size
+         */
+        inline void TransformBoxes(Matrix4x4 const* const* matrices, BOXES const& boxes, BOXES& output)
+        {
+            size_t count = boxes.Size();
+            output.Resize(count);
+
+            size_t i = 0;
+            #if defined(MATHS_SIMD)
+            for(; i + 4 <= count; i += 4) {
+                Simd::FLOAT4 values[4][3];
+                Batch::LoadTransposed(matrices + i, values);
+                Batch::TransformTransposed(values, boxes.min, i, output.min);
+                Batch::TransformTransposed(values, boxes.max, i, output.max);
+            }
+            #endif
+
+            for(; i<count; i++) {
+                output.min.Set(i, *matrices[i] * boxes.min.Get(i));
+                output.max.Set(i, *matrices[i] * boxes.max.Get(i));
+            }
+        }
+
+        /**
+         * Batch version of aabb_inside_half_space, a box is kept when it is inside every half-space
+         * @param boxes Hit-boxes
+         * @param planes Half-spaces, normals point inside
+         * @param plane_count Number of planes
+         * @param[out] inside One value per box, 1 if the box is inside every half-space
+         */
+        inline void BoxesInsideHalfSpaces(BOXES const& boxes, Plane const* planes, uint8_t plane_count, std::vector<uint8_t>& inside)
+        {
+            size_t count = boxes.Size();
+            inside.resize(count);
+
+            size_t i = 0;
+            #if defined(MATHS_SIMD)
+            Simd::FLOAT4 half = Simd::Splat(0.5f);
+            Simd::FLOAT4 zero = Simd::Splat(0.0f);
+            for(; i + 4 <= count; i += 4) {
+                Simd::FLOAT4 center_x = Simd::Mul(Simd::Add(Simd::LoadUnaligned(boxes.min.x.data() + i), Simd::LoadUnaligned(boxes.max.x.data() + i)), half);
+                Simd::FLOAT4 center_y = Simd::Mul(Simd::Add(Simd::LoadUnaligned(boxes.min.y.data() + i), Simd::LoadUnaligned(boxes.max.y.data() + i)), half);
+                Simd::FLOAT4 center_z = Simd::Mul(Simd::Add(Simd::LoadUnaligned(boxes.min.z.data() + i), Simd::LoadUnaligned(boxes.max.z.data() + i)), half);
+
+                // Every plane is tested, branching on the mask costs more than the arithmetic
+                uint8_t mask = 0xF;
+                for(uint8_t p=0; p<plane_count; p++) {
+                    Simd::FLOAT4 distance = Simd::Mul(Simd::Splat(planes[p].normal.x), Simd::Sub(center_x, Simd::Splat(planes[p].origin.x)));
+                    distance = Simd::MulAdd(Simd::Splat(planes[p].normal.y), Simd::Sub(center_y, Simd::Splat(planes[p].origin.y)), distance);
+                    distance = Simd::MulAdd(Simd::Splat(planes[p].normal.z), Simd::Sub(center_z, Simd::Splat(planes[p].origin.z)), distance);
+                    mask &= Simd::Mask(Simd::GreaterEqual(distance, zero));
+                }
+
+                Batch::ExpandMask(mask, inside.data() + i);
+            }
+            #endif
+
+            for(; i<count; i++) {
+                Vector3 box_min = boxes.min.Get(i);
+                Vector3 box_max = boxes.max.Get(i);
+                inside[i] = 1;
+                for(uint8_t p=0; p<plane_count && inside[i]; p++)
+                    if(!aabb_inside_half_space(planes[p], box_min, box_max)) inside[i] = 0;
+            }
+        }
+
+        /**
+         * Batch version of ray_box_aabb_intersect
+         * @param ray_origin Ray origin point
+         * @param ray_direction Ray direction vector, must be normalized
+         * @param boxes Hit-boxes
+         * @param min_range Intersection minimal limit
+         * @param max_range Intersection maximal limit
+         * @param[out] hits One value per box, 1 if the ray intersects the box
+         */
+        inline void RayIntersectBoxes(Vector3 const& ray_origin, Vector3 const& ray_direction, BOXES const& boxes, float min_range, float max_range, std::vector<uint8_t>& hits)
+        {
+            size_t count = boxes.Size();
+            hits.resize(count);
+
+            size_t i = 0;
+            #if defined(MATHS_SIMD)
+            Vector3 inverse_ray = 1.0f / ray_direction;
+            Simd::FLOAT4 origin[3] = {Simd::Splat(ray_origin.x), Simd::Splat(ray_origin.y), Simd::Splat(ray_origin.z)};
+            Simd::FLOAT4 inverse[3] = {Simd::Splat(inverse_ray.x), Simd::Splat(inverse_ray.y), Simd::Splat(inverse_ray.z)};
+            float const* mins[3] = {boxes.min.x.data(), boxes.min.y.data(), boxes.min.z.data()};
+            float const* maxs[3] = {boxes.max.x.data(), boxes.max.y.data(), boxes.max.z.data()};
+
+            for(; i + 4 <= count; i += 4) {
+                Simd::FLOAT4 t_min = Simd::Splat(min_range);
+                Simd::FLOAT4 t_max = Simd::Splat(max_range);
+                for(uint8_t axis=0; axis<3; axis++) {
+                    Simd::FLOAT4 t0 = Simd::Mul(Simd::Sub(Simd::LoadUnaligned(mins[axis] + i), origin[axis]), inverse[axis]);
+                    Simd::FLOAT4 t1 = Simd::Mul(Simd::Sub(Simd::LoadUnaligned(maxs[axis] + i), origin[axis]), inverse[axis]);
+                    t_min = Simd::Max(t_min, Simd::Min(t0, t1));
+                    t_max = Simd::Min(t_max, Simd::Max(t0, t1));
+                }
+
+                Batch::ExpandMask(Simd::Mask(Simd::Less(t_min, t_max)), hits.data() + i);
+            }
+            #endif
+
+            for(; i<count; i++)
+                hits[i] = ray_box_aabb_intersect(ray_origin, ray_direction, boxes.min.Get(i), boxes.max.Get(i), min_range, max_range) ? 1 : 0;
+        }
+    }
+}
\ No newline at end of file
@@ -1,16 +1,13 @@
 #pragma once
 
-#define VECTOR_N 4
-#include "./Vector/Vector.hpp"
-
-#define VECTOR_N 3
-#include "./Vector/Vector.hpp"
-
-#define VECTOR_N 2
 #include "./Vector/Vector.hpp"
 
 #include "./Matrix/Matrix.hpp"
 #include "./Others/Others.hpp"
+#include "./Quaternion/Quaternion.hpp"
+#include "./Quaternion/DualQuaternion.hpp"
+#include "./Transform/Transform.hpp"
+#include "./Batch/Batch.hpp"
 
 namespace Maths
 {
@@ -1,67 +1,201 @@
 #pragma once
 
-#define VECTOR_N 4
-#include "../Vector/Vector.hpp"
+#include <array>
+#include <cmath>
+#include <utility>
 
-#define VECTOR_N 3
 #include "../Vector/Vector.hpp"
 
-#include <array>
-#include <cmath>
+#include "../Simd/Simd.hpp"
 
 #define IDENTITY_MATRIX {1,0,0,0,0,1,0,0,0,0,1,0,0,0,0,1}
 #define ZERO_MATRIX {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}
 
 namespace Maths
 {
-    class Matrix4x4
+    /**
+     * Column major matrix of R rows and C columns, every operation can be evaluated at compile time.
+     * Matrix<float, 4, 4> is specialized below with the SIMD operations and the transformation helpers.
+     */
+    template<typename T, size_t R, size_t C>
+    class Matrix
     {
         private :
+
+            std::array<T, R * C> value;
+
+            template<size_t... I>
+            static constexpr std::array<T, R * C> Identity(std::index_sequence<I...>) { return {{ (I % R == I / R ? T(1) : T(0))... }}; }
+
+            /// Value at index of the product this * other
+            template<size_t K>
+            constexpr T ProductValue(Matrix<T, C, K> const& other, size_t index) const
+            {
+                T result = T();
+                for(size_t i=0; i<C; i++) result += (*this)(index % R, i) * other(i, index / R);
+                return result;
+            }
+
+            template<size_t K, size_t... I>
+            constexpr Matrix<T, R, K> Product(Matrix<T, C, K> const& other, std::index_sequence<I...>) const { return std::array<T, R * K>{{ this->ProductValue(other, I)... }}; }
+
+            /// Row of the product this * vector
+            constexpr T ProductValue(Vector<T, C> const& vector, size_t row) const
+            {
+                T result = T();
+                for(size_t i=0; i<C; i++) result += (*this)(row, i) * vector[i];
+                return result;
+            }
+
+            template<size_t... I>
+            constexpr Vector<T, R> Product(Vector<T, C> const& vector, std::index_sequence<I...>) const { return Vector<T, R>(this->ProductValue(vector, I)...); }
+
+            template<size_t... I>
+            constexpr Matrix<T, C, R> Transpose(std::index_sequence<I...>) const { return std::array<T, R * C>{{ this->value[(I % C) * R + I / C]... }}; }
+
+        public :
+
+            /// Identity, ones on the diagonal
+            constexpr Matrix() : value(Matrix::Identity(std::make_index_sequence<R * C>())) {}
+            constexpr Matrix(std::array<T, R * C> const& other) : value(other) {}
+
+            /// Get reference or Set Matrix[i]
+            constexpr T& operator[](size_t index){ return this->value[index]; }
+
+            /// Get const Matrix[i]
+            constexpr T operator[](size_t index) const { return this->value[index]; }
+
+            /// Get const element
+            constexpr T operator()(size_t row, size_t column) const { return this->value[column * R + row]; }
+
+            /// Column major values
+            constexpr T const* Data() const { return this->value.data(); }
+
+            constexpr bool operator==(Matrix const& other) const
+            {
+                for(size_t i=0; i<R * C; i++) if(this->value[i] != other.value[i]) return false;
+                return true;
+            }
+
+            constexpr bool operator!=(Matrix const& other) const { return !(*this == other); }
+
+            template<size_t K>
+            constexpr Matrix<T, R, K> operator*(Matrix<T, C, K> const& other) const { return this->Product(other, std::make_index_sequence<R * K>()); }
+
+            constexpr Vector<T, R> operator*(Vector<T, C> const& vector) const { return this->Product(vector, std::make_index_sequence<R>()); }
+
+            constexpr Matrix<T, C, R> Transpose() const { return this->Transpose(std::make_index_sequence<R * C>()); }
+    };
+
+    typedef Matrix<float, 4, 4> Matrix4x4;
+
+    /**
+     * 4x4 float matrix used for the transformations, with SIMD products
+     */
+    template<>
+    class Matrix<float, 4, 4>
+    {
+        private :
+
+            /// No alignment is required : matrices are also read in place from packed data and 8 bytes aligned heap blocks,
+            /// SIMD code only uses unaligned loads and stores, as fast as aligned ones on aligned data
             std::array<float,16> value;
 
+            #if defined(MATHS_SIMD)
+            /// 2x2 row major matrices product a * b
+            static inline Simd::FLOAT4 Multiply2x2(Simd::FLOAT4 a, Simd::FLOAT4 b)
+            {
+                return Simd::Add(Simd::Mul(a, Simd::Shuffle<0,3,0,3>(b, b)), Simd::Mul(Simd::Shuffle<1,0,3,2>(a, a), Simd::Shuffle<2,1,2,1>(b, b)));
+            }
+
+            /// 2x2 row major matrices product adjugate(a) * b
+            static inline Simd::FLOAT4 AdjugateMultiply2x2(Simd::FLOAT4 a, Simd::FLOAT4 b)
+            {
+                return Simd::Sub(Simd::Mul(Simd::Shuffle<3,3,0,0>(a, a), b), Simd::Mul(Simd::Shuffle<1,1,2,2>(a, a), Simd::Shuffle<2,3,0,1>(b, b)));
+            }
+
+            /// 2x2 row major matrices product a * adjugate(b)
+            static inline Simd::FLOAT4 MultiplyAdjugate2x2(Simd::FLOAT4 a, Simd::FLOAT4 b)
+            {
+                return Simd::Sub(Simd::Mul(a, Simd::Shuffle<3,0,3,0>(b, b)), Simd::Mul(Simd::Shuffle<1,0,3,2>(a, a), Simd::Shuffle<2,1,2,1>(b, b)));
+            }
+            #endif
+
         public :
 
             enum EULER_ORDER {ZYX, YZX, XZY, ZXY, YXZ, XYZ};
 
-            inline Matrix4x4() : value(IDENTITY_MATRIX) {}
-            inline Matrix4x4(Matrix4x4 const& other) : value(other.value) {}
-            inline Matrix4x4(std::array<float,16> const& other) : value(other) {}
-            inline Matrix4x4(Matrix4x4&& other) { this->value = std::move(other.value); }
-            inline Matrix4x4(std::array<float,16>&& other) : value(other) {}
+            constexpr Matrix() : value(IDENTITY_MATRIX) {}
+            constexpr Matrix(std::array<float,16> const& other) : value(other) {}
 
             /// Get reference or Set Matrix4x4[i]
             inline float& operator[](uint32_t index){ return this->value[index]; }
 
             /// Get const Matrix4x4[i]
-            inline float operator[](uint32_t index) const { return this->value[index]; }
+            constexpr float operator[](uint32_t index) const { return this->value[index]; }
 
-            /// Copy assignment
-            inline Matrix4x4& operator=(Matrix4x4 const& other) { if(this != &other) this->value = other.value; return *this; }
+            /// Get const element
+            constexpr float operator()(size_t row, size_t column) const { return this->value[column * 4 + row]; }
 
-            /// Move assignment
-            inline Matrix4x4& operator=(Matrix4x4&& other) { if(this != &other) this->value = std::move(other.value); return *this; }
+            /// Column major values
+            inline float const* Data() const { return this->value.data(); }
 
             /// Equality operator
-            inline bool operator==(Matrix4x4 const& other) const { return this->value == other.value; }
+            constexpr bool operator==(Matrix4x4 const& other) const
+            {
+                for(uint8_t i=0; i<16; i++) if(this->value[i] != other.value[i]) return false;
+                return true;
+            }
 
             /// Inequality operator
-            inline bool operator!=(Matrix4x4 const& other) const { return this->value != other.value; }
+            constexpr bool operator!=(Matrix4x4 const& other) const { return !(*this == other); }
 
-            inline Matrix4x4(float const x1, float const y1, float const z1, float const w1,
+            constexpr Matrix(float const x1, float const y1, float const z1, float const w1,
                              float const x2, float const y2, float const z2, float const w2,
                              float const x3, float const y3, float const z3, float const w3,
                              float const x4, float const y4, float const z4, float const w4)
-            {
-                this->value = {
+                : value({{
                     x1, y1, z1, w1,
                     x2, y2, z2, w2,
                     x3, y3, z3, w3,
                     x4, y4, z4, w4
-                };
-            }
+                }}) {}
 
             inline Matrix4x4 operator*(Matrix4x4 const& other) const
             {
+                #if defined(MATHS_AVX)
+                // Two result columns at once, each 128 bits lane is a combination of this matrix columns
+                Matrix4x4 result;
+                __m256 column_0 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(this->value.data()));
+                __m256 column_1 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(this->value.data() + 4));
+                __m256 column_2 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(this->value.data() + 8));
+                __m256 column_3 = _mm256_broadcast_ps(reinterpret_cast<__m128 const*>(this->value.data() + 12));
+                for(uint8_t i=0; i<2; i++) {
+                    __m256 factors = _mm256_loadu_ps(other.value.data() + i * 8);
+                    __m256 columns = _mm256_mul_ps(column_0, _mm256_permute_ps(factors, 0x00));
+                    #if defined(MATHS_FMA)
+                    columns = _mm256_fmadd_ps(column_1, _mm256_permute_ps(factors, 0x55), columns);
+                    columns = _mm256_fmadd_ps(column_2, _mm256_permute_ps(factors, 0xAA), columns);
+                    columns = _mm256_fmadd_ps(column_3, _mm256_permute_ps(factors, 0xFF), columns);
+                    #else
+                    columns = _mm256_add_ps(columns, _mm256_mul_ps(column_1, _mm256_permute_ps(factors, 0x55)));
+                    columns = _mm256_add_ps(columns, _mm256_mul_ps(column_2, _mm256_permute_ps(factors, 0xAA)));
+                    columns = _mm256_add_ps(columns, _mm256_mul_ps(column_3, _mm256_permute_ps(factors, 0xFF)));
+                    #endif
+                    _mm256_storeu_ps(result.value.data() + i * 8, columns);
+                }
+                return result;
+                #elif defined(MATHS_SIMD)
+                // Each result column is a combination of this matrix columns
+                Matrix4x4 result;
+                Simd::FLOAT4 column_0 = Simd::LoadUnaligned(this->value.data());
+                Simd::FLOAT4 column_1 = Simd::LoadUnaligned(this->value.data() + 4);
+                Simd::FLOAT4 column_2 = Simd::LoadUnaligned(this->value.data() + 8);
+                Simd::FLOAT4 column_3 = Simd::LoadUnaligned(this->value.data() + 12);
+                for(uint8_t i=0; i<4; i++)
+                    Simd::StoreUnaligned(result.value.data() + i * 4, Simd::Combine(column_0, column_1, column_2, column_3, Simd::LoadUnaligned(other.value.data() + i * 4)));
+                return result;
+                #else
                 return {
                     this->value[0] * other[0] + this->value[4] * other[1] + this->value[8] * other[2] + this->value[12] * other[3],
                     this->value[1] * other[0] + this->value[5] * other[1] + this->value[9] * other[2] + this->value[13] * other[3],
@@ -83,26 +217,39 @@ namespace Maths
                     this->value[2] * other[12] + this->value[6] * other[13] + this->value[10] * other[14] + this->value[14] * other[15],
                     this->value[3] * other[12] + this->value[7] * other[13] + this->value[11] * other[14] + this->value[15] * other[15]
                 };
+                #endif
             }
 
             inline Vector4 operator*(Vector4 const& vertex) const
             {
+                #if defined(MATHS_SIMD)
+                return Vector4(Simd::Combine(Simd::LoadUnaligned(this->value.data()), Simd::LoadUnaligned(this->value.data() + 4), Simd::LoadUnaligned(this->value.data() + 8),
+                                             Simd::LoadUnaligned(this->value.data() + 12), vertex.ToSimd()));
+                #else
                 return {
                     this->value[0] * vertex[0] + this->value[4] * vertex[1] + this->value[8]  * vertex[2] + this->value[12] * vertex[3],
                     this->value[1] * vertex[0] + this->value[5] * vertex[1] + this->value[9]  * vertex[2] + this->value[13] * vertex[3],
                     this->value[2] * vertex[0] + this->value[6] * vertex[1] + this->value[10] * vertex[2] + this->value[14] * vertex[3],
                     this->value[3] * vertex[0] + this->value[7] * vertex[1] + this->value[11] * vertex[2] + this->value[15] * vertex[3]
                 };
+                #endif
             }
 
             inline Vector4 operator*(Vector3 const& vertex) const
             {
+                #if defined(MATHS_SIMD)
+                // w = 1 : the last column is added as is
+                Simd::FLOAT4 result = Simd::MulAdd(Simd::LoadUnaligned(this->value.data()), Simd::Splat(vertex.x), Simd::LoadUnaligned(this->value.data() + 12));
+                result = Simd::MulAdd(Simd::LoadUnaligned(this->value.data() + 4), Simd::Splat(vertex.y), result);
+                return Vector4(Simd::MulAdd(Simd::LoadUnaligned(this->value.data() + 8), Simd::Splat(vertex.z), result));
+                #else
                 return {
                     this->value[0] * vertex[0] + this->value[4] * vertex[1] + this->value[8]  * vertex[2] + this->value[12],
                     this->value[1] * vertex[0] + this->value[5] * vertex[1] + this->value[9]  * vertex[2] + this->value[13],
                     this->value[2] * vertex[0] + this->value[6] * vertex[1] + this->value[10] * vertex[2] + this->value[14],
                     this->value[3] * vertex[0] + this->value[7] * vertex[1] + this->value[11] * vertex[2] + this->value[15]
                 };
+                #endif
             }
 
             static inline Matrix4x4 PerspectiveProjectionMatrix(float const aspect_ratio, float const field_of_view, float const near_clip, float const far_clip)
@@ -117,8 +264,8 @@ namespace Maths
                 };
             }
 
-            static inline Matrix4x4 OrthographicProjectionMatrix(float const left_plane, float const right_plane, float const top_plane,
-                                                              float const bottom_plane, float const near_plane, float const far_plane)
+            static constexpr Matrix4x4 OrthographicProjectionMatrix(float const left_plane, float const right_plane, float const top_plane,
+                                                                 float const bottom_plane, float const near_plane, float const far_plane)
             {
                 return {
                     2.0f / (right_plane - left_plane), 0.0f, 0.0f, 0.0f,
@@ -227,7 +374,7 @@ namespace Maths
                 });
             }
 
-            static inline Matrix4x4 TranslationMatrix(Vector3 const& vector)
+            static constexpr Matrix4x4 TranslationMatrix(Vector3 const& vector)
             {
                 return {
                     1.0f,      0.0f,      0.0f,         0.0f,
@@ -358,7 +505,7 @@ namespace Maths
 		        return result;
             }
 
-            static inline Matrix4x4 ScalingMatrix(Vector3 const& vector)
+            static constexpr Matrix4x4 ScalingMatrix(Vector3 const& vector)
             {
                 return {
                     vector[0],  0.0f,       0.0f,       0.0f,
@@ -382,7 +529,7 @@ namespace Maths
                 };
             }
 
-            inline Matrix4x4 ExtractTranslation() const
+            constexpr Matrix4x4 ExtractTranslation() const
             {
                 return {
                     1.0f,               0.0f,               0.0f,               0.0f,
@@ -399,7 +546,7 @@ namespace Maths
                 this->value[14] = translation.z;
             }
 
-            inline Vector3 GetTranslation() const
+            constexpr Vector3 GetTranslation() const
             {
                 return {
                     this->value[12],
@@ -408,7 +555,7 @@ namespace Maths
                 };
             }
 
-            inline Matrix4x4 ToTranslationMatrix() const
+            constexpr Matrix4x4 ToTranslationMatrix() const
             {
                 return {
                     1.0f,               0.0f,               0.0f,               0.0f,
@@ -422,6 +569,56 @@ namespace Maths
             {
                 Matrix4x4 result;
 
+                #if defined(MATHS_SIMD)
+                // Block inversion on 2x2 sub-matrices, columns are handled as rows since inverse(transpose(M)) = transpose(inverse(M))
+                Simd::FLOAT4 row_0 = Simd::LoadUnaligned(this->value.data());
+                Simd::FLOAT4 row_1 = Simd::LoadUnaligned(this->value.data() + 4);
+                Simd::FLOAT4 row_2 = Simd::LoadUnaligned(this->value.data() + 8);
+                Simd::FLOAT4 row_3 = Simd::LoadUnaligned(this->value.data() + 12);
+
+                // M = | A B |
+                //     | C D |
+                Simd::FLOAT4 a = Simd::MoveLow(row_0, row_1);
+                Simd::FLOAT4 b = Simd::MoveHigh(row_0, row_1);
+                Simd::FLOAT4 c = Simd::MoveLow(row_2, row_3);
+                Simd::FLOAT4 d = Simd::MoveHigh(row_2, row_3);
+
+                // (|A|, |B|, |C|, |D|)
+                Simd::FLOAT4 determinants = Simd::Sub(Simd::Mul(Simd::Shuffle<0,2,0,2>(row_0, row_2), Simd::Shuffle<1,3,1,3>(row_1, row_3)),
+                                                      Simd::Mul(Simd::Shuffle<1,3,1,3>(row_0, row_2), Simd::Shuffle<0,2,0,2>(row_1, row_3)));
+                Simd::FLOAT4 det_a = Simd::Lane<0>(determinants);
+                Simd::FLOAT4 det_b = Simd::Lane<1>(determinants);
+                Simd::FLOAT4 det_c = Simd::Lane<2>(determinants);
+                Simd::FLOAT4 det_d = Simd::Lane<3>(determinants);
+
+                // inverse(M) = 1 / |M| * adjugate(| X Y |)
+                //                                 (| Z W |)
+                Simd::FLOAT4 d_c = Matrix4x4::AdjugateMultiply2x2(d, c);
+                Simd::FLOAT4 a_b = Matrix4x4::AdjugateMultiply2x2(a, b);
+                Simd::FLOAT4 x = Simd::Sub(Simd::Mul(det_d, a), Matrix4x4::Multiply2x2(b, d_c));
+                Simd::FLOAT4 w = Simd::Sub(Simd::Mul(det_a, d), Matrix4x4::Multiply2x2(c, a_b));
+                Simd::FLOAT4 y = Simd::Sub(Simd::Mul(det_b, c), Matrix4x4::MultiplyAdjugate2x2(d, a_b));
+                Simd::FLOAT4 z = Simd::Sub(Simd::Mul(det_c, b), Matrix4x4::MultiplyAdjugate2x2(a, d_c));
+
+                // |M| = |A| * |D| + |B| * |C| - trace(adjugate(A) * B * adjugate(D) * C)
+                Simd::FLOAT4 det = Simd::Add(Simd::Mul(det_a, det_d), Simd::Mul(det_b, det_c));
+                det = Simd::Sub(det, Simd::Sum(Simd::Mul(a_b, Simd::Shuffle<0,2,1,3>(d_c, d_c))));
+                if(Simd::First(det) == 0) return IDENTITY_MATRIX;
+
+                Simd::FLOAT4 inverse_det = Simd::Div(Simd::Set(1.0f, -1.0f, -1.0f, 1.0f), det);
+                x = Simd::Mul(x, inverse_det);
+                y = Simd::Mul(y, inverse_det);
+                z = Simd::Mul(z, inverse_det);
+                w = Simd::Mul(w, inverse_det);
+
+                // Adjugate of each block while going back to 4x4 storage
+                Simd::StoreUnaligned(result.value.data(), Simd::Shuffle<3,1,3,1>(x, y));
+                Simd::StoreUnaligned(result.value.data() + 4, Simd::Shuffle<2,0,2,0>(x, y));
+                Simd::StoreUnaligned(result.value.data() + 8, Simd::Shuffle<3,1,3,1>(z, w));
+                Simd::StoreUnaligned(result.value.data() + 12, Simd::Shuffle<2,0,2,0>(z, w));
+                return result;
+                #else
+
 		        float n11 = this->value[0],  n21 = this->value[1],  n31 = this->value[2],  n41 = this->value[3],
 		              n12 = this->value[4],  n22 = this->value[5],  n32 = this->value[6],  n42 = this->value[7],
 		              n13 = this->value[8],  n23 = this->value[9],  n33 = this->value[10], n43 = this->value[11],
@@ -460,16 +657,31 @@ namespace Maths
 		        result[15] = (n12 * n23 * n31 - n13 * n22 * n31 + n13 * n21 * n32 - n11 * n23 * n32 - n12 * n21 * n33 + n11 * n22 * n33) * detInv;
 
 		        return result;
+                #endif
             }
 
             inline Matrix4x4 Transpose() const
             {
+                #if defined(MATHS_SIMD)
+                Matrix4x4 result;
+                Simd::FLOAT4 column_0 = Simd::LoadUnaligned(this->value.data());
+                Simd::FLOAT4 column_1 = Simd::LoadUnaligned(this->value.data() + 4);
+                Simd::FLOAT4 column_2 = Simd::LoadUnaligned(this->value.data() + 8);
+                Simd::FLOAT4 column_3 = Simd::LoadUnaligned(this->value.data() + 12);
+                Simd::Transpose(column_0, column_1, column_2, column_3);
+                Simd::StoreUnaligned(result.value.data(), column_0);
+                Simd::StoreUnaligned(result.value.data() + 4, column_1);
+                Simd::StoreUnaligned(result.value.data() + 8, column_2);
+                Simd::StoreUnaligned(result.value.data() + 12, column_3);
+                return result;
+                #else
                 return {
                     this->value[0], this->value[4], this->value[8], this->value[12],
                     this->value[1], this->value[5], this->value[9], this->value[13],
                     this->value[2], this->value[6], this->value[10], this->value[14],
                     this->value[3], this->value[7], this->value[11], this->value[15]
                 };
+                #endif
             }
     };
 }
\ No newline at end of file
@@ -78,4 +78,16 @@ namespace Maths
         if(source <= dest) return source + std::abs(dest - source) * ratio;
         else return source - std::abs(dest - source) * ratio;
     }
+
+    /**
+     * Number of cells of a hexagonal group : the center cell and 6 more cells on each new ring (1, 7, 19, 37...)
+     * @param scale Number of rings, the center cell counts as the first one
+     * @return Cell count, evaluated at compile time when scale is constant
+     */
+    constexpr uint32_t hexagon_cell_count(int scale)
+    {
+        return scale > 1 ? static_cast<uint32_t>(1 + 3 * scale * (scale - 1)) : 1;
+    }
+
+    static_assert(hexagon_cell_count(1) == 1 && hexagon_cell_count(2) == 7 && hexagon_cell_count(3) == 19, "Hexagonal cell count");
 }
\ No newline at end of file
@@ -1,6 +1,5 @@
 #pragma once
 
-#define VECTOR_N 3
 #include "../Vector/Vector.hpp"
 
 namespace Maths
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Quaternion.hpp"
+
+namespace Maths
+{
+    /**
+     * Unit dual quaternion representing a rigid transformation (rotation then translation) in 8 floats.
+     * Blending dual quaternions keeps the volume of the skin where blending matrices collapses it.
+     */
+    class DualQuaternion
+    {
+        public :
+
+            Quaternion real;    // Rotation
+            Quaternion dual;    // Translation * rotation / 2
+
+            /// Identity transformation
+            constexpr DualQuaternion() : real(), dual(0.0f, 0.0f, 0.0f, 0.0f) {}
+            constexpr DualQuaternion(Quaternion const& real, Quaternion const& dual) : real(real), dual(dual) {}
+
+            /**
+             * Rigid transformation, same as TranslationMatrix(translation) * rotation.ToMatrix()
+             * @param rotation Unit quaternion
+             * @param translation Applied after the rotation
+             */
+            constexpr DualQuaternion(Quaternion const& rotation, Vector3 const& translation)
+                : real(rotation), dual(Quaternion(translation.x, translation.y, translation.z, 0.0f) * rotation * 0.5f) {}
+
+            constexpr DualQuaternion operator+(DualQuaternion const& other) const { return { this->real + other.real, this->dual + other.dual }; }
+            constexpr DualQuaternion operator*(float const scalar) const { return { this->real * scalar, this->dual * scalar }; }
+
+            /// Composition, the result applies other first then this
+            constexpr DualQuaternion operator*(DualQuaternion const& other) const
+            {
+                return { this->real * other.real, this->real * other.dual + this->dual * other.real };
+            }
+
+            /// Transform a point
+            constexpr Vector3 operator*(Vector3 const& point) const { return this->real * point + this->GetTranslation(); }
+
+            /// Inverse of a unit dual quaternion
+            constexpr DualQuaternion Inverse() const { return { this->real.Conjugate(), this->dual.Conjugate() }; }
+
+            /// Scale back to a unit dual quaternion, needed after a blend
+            inline DualQuaternion Normalize() const
+            {
+                float inverse_length = 1.0f / this->real.Length();
+                return { this->real * inverse_length, this->dual * inverse_length };
+            }
+
+            constexpr Quaternion GetRotation() const { return this->real; }
+
+            constexpr Vector3 GetTranslation() const
+            {
+                Quaternion translation = this->dual * this->real.Conjugate();
+                return { translation.x * 2.0f, translation.y * 2.0f, translation.z * 2.0f };
+            }
+
+            /// Rigid transformation part of a matrix, the matrix must not contain any scaling
+            static inline DualQuaternion FromMatrix(Matrix4x4 const& matrix)
+            {
+                return DualQuaternion(Quaternion::FromMatrix(matrix), matrix.GetTranslation());
+            }
+
+            /// Matrix of the rigid transformation, column major
+            inline Matrix4x4 ToMatrix() const
+            {
+                Matrix4x4 result = this->real.ToMatrix();
+                result.SetTranslation(this->GetTranslation());
+                return result;
+            }
+
+            /**
+             * Dual quaternion linear blending, the weights are expected to sum to 1
+             * @param source First transformation
+             * @param dest Second transformation
+             * @param ratio Weight of dest
+             */
+            static inline DualQuaternion Blend(DualQuaternion const& source, DualQuaternion const& dest, float ratio)
+            {
+                // Same hemisphere as the source, otherwise the blend takes the longest path
+                float target = source.real.Dot(dest.real) < 0.0f ? -ratio : ratio;
+                return (source * (1.0f - ratio) + dest * target).Normalize();
+            }
+    };
+}
\ No newline at end of file
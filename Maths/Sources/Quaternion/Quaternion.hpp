@@ -0,0 +1,180 @@
+#pragma once
+
+#include "../Matrix/Matrix.hpp"
+
+namespace Maths
+{
+    /**
+     * Unit quaternion (x, y, z, w) representing a rotation, w is the scalar part.
+     * Rotations follow the matrix convention : q1 * q2 applies q2 first, like Matrix4x4 products.
+     * Every operation is constexpr except the ones relying on <cmath>
+     */
+    class Quaternion
+    {
+        public :
+
+            float x;
+            float y;
+            float z;
+            float w;
+
+            /// Identity rotation
+            constexpr Quaternion() : x(0.0f), y(0.0f), z(0.0f), w(1.0f) {}
+            constexpr Quaternion(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+            constexpr Quaternion(std::array<float, 4> const& list) : x(list[0]), y(list[1]), z(list[2]), w(list[3]) {}
+
+            constexpr bool operator==(Quaternion const& other) const { return this->x == other.x && this->y == other.y && this->z == other.z && this->w == other.w; }
+            constexpr bool operator!=(Quaternion const& other) const { return !(*this == other); }
+
+            /// Get reference or Set Quaternion[i]
+            constexpr float& operator[](uint32_t index){ return index == 0 ? this->x : index == 1 ? this->y : index == 2 ? this->z : this->w; }
+
+            /// Get const Quaternion[i]
+            constexpr float operator[](uint32_t index) const { return index == 0 ? this->x : index == 1 ? this->y : index == 2 ? this->z : this->w; }
+
+            /// Component wise operators, used by interpolations and dual quaternions
+            /// @{
+            constexpr Quaternion operator+(Quaternion const& other) const { return { this->x + other.x, this->y + other.y, this->z + other.z, this->w + other.w }; }
+            constexpr Quaternion operator-(Quaternion const& other) const { return { this->x - other.x, this->y - other.y, this->z - other.z, this->w - other.w }; }
+            constexpr Quaternion operator*(float const scalar) const { return { this->x * scalar, this->y * scalar, this->z * scalar, this->w * scalar }; }
+            constexpr Quaternion operator-() const { return { -this->x, -this->y, -this->z, -this->w }; }
+            /// @}
+
+            /// Hamilton product, the result applies other first then this
+            constexpr Quaternion operator*(Quaternion const& other) const
+            {
+                return {
+                    this->w * other.x + this->x * other.w + this->y * other.z - this->z * other.y,
+                    this->w * other.y - this->x * other.z + this->y * other.w + this->z * other.x,
+                    this->w * other.z + this->x * other.y - this->y * other.x + this->z * other.w,
+                    this->w * other.w - this->x * other.x - this->y * other.y - this->z * other.z
+                };
+            }
+
+            /// Rotate a vector, cheaper than building the matrix for a single vector
+            constexpr Vector3 operator*(Vector3 const& vector) const
+            {
+                // v' = v + 2w(u x v) + 2u x (u x v), u being the vector part
+                Vector3 axis(this->x, this->y, this->z);
+                Vector3 t = axis.Cross(vector) * 2.0f;
+                return vector + t * this->w + axis.Cross(t);
+            }
+
+            constexpr float Dot(Quaternion const& other) const { return this->x * other.x + this->y * other.y + this->z * other.z + this->w * other.w; }
+            inline float Length() const { return std::sqrt(this->Dot(*this)); }
+            inline Quaternion Normalize() const { return *this * (1.0f / this->Length()); }
+
+            /// Inverse of a unit quaternion
+            constexpr Quaternion Conjugate() const { return { -this->x, -this->y, -this->z, this->w }; }
+
+            /// Inverse of any non zero quaternion
+            constexpr Quaternion Inverse() const { return this->Conjugate() * (1.0f / this->Dot(*this)); }
+
+            /**
+             * Rotation around an axis
+             * @param angle Angle in radians
+             * @param axis Normalized axis
+             */
+            static inline Quaternion AxisAngle(float angle, Vector3 const& axis)
+            {
+                float s = std::sin(angle * 0.5f);
+                return { axis.x * s, axis.y * s, axis.z * s, std::cos(angle * 0.5f) };
+            }
+
+            /**
+             * Same rotation as Matrix4x4::EulerRotation, without building the matrix
+             * @param vector Angles in radians
+             * @param order Rotation order, ZYX means Rz * Ry * Rx
+             */
+            static inline Quaternion FromEuler(Vector3 const& vector, Matrix4x4::EULER_ORDER order)
+            {
+                float c1 = std::cos(vector.x * 0.5f), s1 = std::sin(vector.x * 0.5f);
+                float c2 = std::cos(vector.y * 0.5f), s2 = std::sin(vector.y * 0.5f);
+                float c3 = std::cos(vector.z * 0.5f), s3 = std::sin(vector.z * 0.5f);
+
+                float x = s1 * c2 * c3, y = c1 * s2 * c3, z = c1 * c2 * s3, w = c1 * c2 * c3;
+                float dx = c1 * s2 * s3, dy = s1 * c2 * s3, dz = s1 * s2 * c3, dw = s1 * s2 * s3;
+
+                switch(order) {
+                    case Matrix4x4::EULER_ORDER::XYZ : return { x + dx, y - dy, z + dz, w - dw };
+                    case Matrix4x4::EULER_ORDER::YXZ : return { x + dx, y - dy, z - dz, w + dw };
+                    case Matrix4x4::EULER_ORDER::ZXY : return { x - dx, y + dy, z + dz, w - dw };
+                    case Matrix4x4::EULER_ORDER::ZYX : return { x - dx, y + dy, z - dz, w + dw };
+                    case Matrix4x4::EULER_ORDER::YZX : return { x + dx, y + dy, z - dz, w - dw };
+                    case Matrix4x4::EULER_ORDER::XZY : return { x - dx, y - dy, z + dz, w + dw };
+                }
+
+                return {};
+            }
+
+            /**
+             * Rotation part of a matrix, the matrix must not contain any scaling
+             */
+            static inline Quaternion FromMatrix(Matrix4x4 const& rotation)
+            {
+                // Column major storage : element (row, column) is at column * 4 + row
+                auto m = [&](uint8_t row, uint8_t column) { return rotation[column * 4 + row]; };
+
+                Quaternion result;
+                float trace = m(0, 0) + m(1, 1) + m(2, 2);
+                if(trace > 0.0f) {
+                    float s = std::sqrt(trace + 1.0f) * 2.0f;
+                    result = { (m(2, 1) - m(1, 2)) / s, (m(0, 2) - m(2, 0)) / s, (m(1, 0) - m(0, 1)) / s, 0.25f * s };
+                }else if(m(0, 0) > m(1, 1) && m(0, 0) > m(2, 2)) {
+                    float s = std::sqrt(1.0f + m(0, 0) - m(1, 1) - m(2, 2)) * 2.0f;
+                    result = { 0.25f * s, (m(0, 1) + m(1, 0)) / s, (m(0, 2) + m(2, 0)) / s, (m(2, 1) - m(1, 2)) / s };
+                }else if(m(1, 1) > m(2, 2)) {
+                    float s = std::sqrt(1.0f + m(1, 1) - m(0, 0) - m(2, 2)) * 2.0f;
+                    result = { (m(0, 1) + m(1, 0)) / s, 0.25f * s, (m(1, 2) + m(2, 1)) / s, (m(0, 2) - m(2, 0)) / s };
+                }else{
+                    float s = std::sqrt(1.0f + m(2, 2) - m(0, 0) - m(1, 1)) * 2.0f;
+                    result = { (m(0, 2) + m(2, 0)) / s, (m(1, 2) + m(2, 1)) / s, 0.25f * s, (m(1, 0) - m(0, 1)) / s };
+                }
+
+                return result.Normalize();
+            }
+
+            /// Rotation matrix, column major
+            constexpr Matrix4x4 ToMatrix() const
+            {
+                float xx = this->x * this->x, yy = this->y * this->y, zz = this->z * this->z;
+                float xy = this->x * this->y, xz = this->x * this->z, yz = this->y * this->z;
+                float wx = this->w * this->x, wy = this->w * this->y, wz = this->w * this->z;
+
+                return {
+                    1.0f - 2.0f * (yy + zz),    2.0f * (xy + wz),           2.0f * (xz - wy),           0.0f,
+                    2.0f * (xy - wz),           1.0f - 2.0f * (xx + zz),    2.0f * (yz + wx),           0.0f,
+                    2.0f * (xz + wy),           2.0f * (yz - wx),           1.0f - 2.0f * (xx + yy),    0.0f,
+                    0.0f,                       0.0f,                       0.0f,                       1.0f
+                };
+            }
+
+            /**
+             * Normalized linear interpolation along the shortest path.
+             * Not constant speed, but much cheaper than Slerp and close enough for consecutive keyframes
+             */
+            static inline Quaternion Nlerp(Quaternion const& source, Quaternion const& dest, float ratio)
+            {
+                float target = source.Dot(dest) < 0.0f ? -ratio : ratio;
+                return (source * (1.0f - ratio) + dest * target).Normalize();
+            }
+
+            /// Spherical linear interpolation along the shortest path, constant angular speed
+            static inline Quaternion Slerp(Quaternion const& source, Quaternion const& dest, float ratio)
+            {
+                float cos_angle = source.Dot(dest);
+                Quaternion target = dest;
+                if(cos_angle < 0.0f) {
+                    cos_angle = -cos_angle;
+                    target = -dest;
+                }
+
+                // Nearly identical rotations : sin(angle) tends to zero, the linear interpolation is exact enough
+                if(cos_angle > 0.9995f) return (source * (1.0f - ratio) + target * ratio).Normalize();
+
+                float angle = std::acos(cos_angle);
+                float inverse_sin = 1.0f / std::sin(angle);
+                return source * (std::sin((1.0f - ratio) * angle) * inverse_sin) + target * (std::sin(ratio * angle) * inverse_sin);
+            }
+    };
+}
\ No newline at end of file
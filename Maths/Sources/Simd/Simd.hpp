@@ -0,0 +1,167 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Backend chosen at compile time, MATHS_SCALAR forces the reference scalar code
+ *   MATHS_AVX  : two matrix columns per register (/arch:AVX, -mavx)
+ *   MATHS_SSE  : x86 / x64, SSE2 is always available on x64
+ *   MATHS_NEON : ARMv8
+ * MATHS_FMA is added when fused multiply-add is available (/arch:AVX2, -mfma, ARMv8)
+ */
+#if !defined(MATHS_SCALAR)
+    #if defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+        #define MATHS_SSE
+        #include <emmintrin.h>
+        #if defined(__AVX__)
+            #define MATHS_AVX
+            #include <immintrin.h>
+        #endif
+        #if defined(__FMA__) || defined(__AVX2__)
+            #define MATHS_FMA
+            #include <immintrin.h>
+        #endif
+    #elif defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+        #define MATHS_NEON
+        #define MATHS_FMA
+        #include <arm_neon.h>
+    #endif
+#endif
+
+#if defined(MATHS_SSE) || defined(MATHS_NEON)
+#define MATHS_SIMD
+
+namespace Maths
+{
+    /**
+     * Thin wrapper over 4 float registers, the matrix and vector code is written once on top of it
+     */
+    namespace Simd
+    {
+        #if defined(MATHS_SSE)
+
+        typedef __m128 FLOAT4;
+
+        /// Data must be 16 bytes aligned
+        inline FLOAT4 Load(float const* data) { return _mm_load_ps(data); }
+        inline FLOAT4 LoadUnaligned(float const* data) { return _mm_loadu_ps(data); }
+        inline void Store(float* data, FLOAT4 value) { _mm_store_ps(data, value); }
+        inline void StoreUnaligned(float* data, FLOAT4 value) { _mm_storeu_ps(data, value); }
+        inline FLOAT4 Set(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+        inline FLOAT4 Splat(float value) { return _mm_set1_ps(value); }
+        inline FLOAT4 Add(FLOAT4 a, FLOAT4 b) { return _mm_add_ps(a, b); }
+        inline FLOAT4 Sub(FLOAT4 a, FLOAT4 b) { return _mm_sub_ps(a, b); }
+        inline FLOAT4 Mul(FLOAT4 a, FLOAT4 b) { return _mm_mul_ps(a, b); }
+        inline FLOAT4 Div(FLOAT4 a, FLOAT4 b) { return _mm_div_ps(a, b); }
+        inline FLOAT4 Min(FLOAT4 a, FLOAT4 b) { return _mm_min_ps(a, b); }
+        inline FLOAT4 Max(FLOAT4 a, FLOAT4 b) { return _mm_max_ps(a, b); }
+        inline float First(FLOAT4 value) { return _mm_cvtss_f32(value); }
+
+        /// Comparisons return all bits set in the lanes where they are true
+        /// @{
+        inline FLOAT4 GreaterEqual(FLOAT4 a, FLOAT4 b) { return _mm_cmpge_ps(a, b); }
+        inline FLOAT4 Less(FLOAT4 a, FLOAT4 b) { return _mm_cmplt_ps(a, b); }
+        inline FLOAT4 And(FLOAT4 a, FLOAT4 b) { return _mm_and_ps(a, b); }
+        /// @}
+
+        /// One bit per lane of a comparison result, lane 0 in the lowest bit
+        inline uint8_t Mask(FLOAT4 value) { return static_cast<uint8_t>(_mm_movemask_ps(value)); }
+
+        /// a * b + c
+        #if defined(MATHS_FMA)
+        inline FLOAT4 MulAdd(FLOAT4 a, FLOAT4 b, FLOAT4 c) { return _mm_fmadd_ps(a, b, c); }
+        #else
+        inline FLOAT4 MulAdd(FLOAT4 a, FLOAT4 b, FLOAT4 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+        #endif
+
+        /// (a[x], a[y], b[z], b[w])
+        template<uint8_t x, uint8_t y, uint8_t z, uint8_t w>
+        inline FLOAT4 Shuffle(FLOAT4 a, FLOAT4 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x)); }
+
+        /// (a[i], a[i], a[i], a[i])
+        template<uint8_t i>
+        inline FLOAT4 Lane(FLOAT4 a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(i, i, i, i)); }
+
+        /// (a[0], a[1], b[0], b[1])
+        inline FLOAT4 MoveLow(FLOAT4 a, FLOAT4 b) { return _mm_movelh_ps(a, b); }
+
+        /// (a[2], a[3], b[2], b[3])
+        inline FLOAT4 MoveHigh(FLOAT4 a, FLOAT4 b) { return _mm_movehl_ps(b, a); }
+
+        inline void Transpose(FLOAT4& a, FLOAT4& b, FLOAT4& c, FLOAT4& d) { _MM_TRANSPOSE4_PS(a, b, c, d); }
+
+        #elif defined(MATHS_NEON)
+
+        typedef float32x4_t FLOAT4;
+
+        inline FLOAT4 Load(float const* data) { return vld1q_f32(data); }
+        inline FLOAT4 LoadUnaligned(float const* data) { return vld1q_f32(data); }
+        inline void Store(float* data, FLOAT4 value) { vst1q_f32(data, value); }
+        inline void StoreUnaligned(float* data, FLOAT4 value) { vst1q_f32(data, value); }
+        inline FLOAT4 Set(float x, float y, float z, float w) { float const values[4] = {x, y, z, w}; return vld1q_f32(values); }
+        inline FLOAT4 Splat(float value) { return vdupq_n_f32(value); }
+        inline FLOAT4 Add(FLOAT4 a, FLOAT4 b) { return vaddq_f32(a, b); }
+        inline FLOAT4 Sub(FLOAT4 a, FLOAT4 b) { return vsubq_f32(a, b); }
+        inline FLOAT4 Mul(FLOAT4 a, FLOAT4 b) { return vmulq_f32(a, b); }
+        inline FLOAT4 Div(FLOAT4 a, FLOAT4 b) { return vdivq_f32(a, b); }
+        inline FLOAT4 Min(FLOAT4 a, FLOAT4 b) { return vminq_f32(a, b); }
+        inline FLOAT4 Max(FLOAT4 a, FLOAT4 b) { return vmaxq_f32(a, b); }
+        inline float First(FLOAT4 value) { return vgetq_lane_f32(value, 0); }
+        inline FLOAT4 GreaterEqual(FLOAT4 a, FLOAT4 b) { return vreinterpretq_f32_u32(vcgeq_f32(a, b)); }
+        inline FLOAT4 Less(FLOAT4 a, FLOAT4 b) { return vreinterpretq_f32_u32(vcltq_f32(a, b)); }
+        inline FLOAT4 And(FLOAT4 a, FLOAT4 b) { return vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(a), vreinterpretq_u32_f32(b))); }
+
+        inline uint8_t Mask(FLOAT4 value)
+        {
+            int32_t const shifts[4] = {0, 1, 2, 3};
+            uint32x4_t bits = vshrq_n_u32(vreinterpretq_u32_f32(value), 31);
+            return static_cast<uint8_t>(vaddvq_u32(vshlq_u32(bits, vld1q_s32(shifts))));
+        }
+        inline FLOAT4 MulAdd(FLOAT4 a, FLOAT4 b, FLOAT4 c) { return vfmaq_f32(c, a, b); }
+
+        template<uint8_t x, uint8_t y, uint8_t z, uint8_t w>
+        inline FLOAT4 Shuffle(FLOAT4 a, FLOAT4 b)
+        {
+            FLOAT4 result = vdupq_n_f32(vgetq_lane_f32(a, x));
+            result = vsetq_lane_f32(vgetq_lane_f32(a, y), result, 1);
+            result = vsetq_lane_f32(vgetq_lane_f32(b, z), result, 2);
+            return vsetq_lane_f32(vgetq_lane_f32(b, w), result, 3);
+        }
+
+        template<uint8_t i>
+        inline FLOAT4 Lane(FLOAT4 a) { return vdupq_laneq_f32(a, i); }
+
+        inline FLOAT4 MoveLow(FLOAT4 a, FLOAT4 b) { return vcombine_f32(vget_low_f32(a), vget_low_f32(b)); }
+        inline FLOAT4 MoveHigh(FLOAT4 a, FLOAT4 b) { return vcombine_f32(vget_high_f32(a), vget_high_f32(b)); }
+
+        inline void Transpose(FLOAT4& a, FLOAT4& b, FLOAT4& c, FLOAT4& d)
+        {
+            float32x4x2_t ab = vtrnq_f32(a, b);
+            float32x4x2_t cd = vtrnq_f32(c, d);
+            a = vcombine_f32(vget_low_f32(ab.val[0]), vget_low_f32(cd.val[0]));
+            b = vcombine_f32(vget_low_f32(ab.val[1]), vget_low_f32(cd.val[1]));
+            c = vcombine_f32(vget_high_f32(ab.val[0]), vget_high_f32(cd.val[0]));
+            d = vcombine_f32(vget_high_f32(ab.val[1]), vget_high_f32(cd.val[1]));
+        }
+
+        #endif
+
+        /// Sum of the 4 components, in every component
+        inline FLOAT4 Sum(FLOAT4 a)
+        {
+            a = Add(a, Shuffle<2, 3, 0, 1>(a, a));
+            return Add(a, Shuffle<1, 0, 3, 2>(a, a));
+        }
+
+        /// Linear combination of 4 columns : column_0 * factors[0] + column_1 * factors[1] + ...
+        inline FLOAT4 Combine(FLOAT4 column_0, FLOAT4 column_1, FLOAT4 column_2, FLOAT4 column_3, FLOAT4 factors)
+        {
+            FLOAT4 result = Mul(column_0, Lane<0>(factors));
+            result = MulAdd(column_1, Lane<1>(factors), result);
+            result = MulAdd(column_2, Lane<2>(factors), result);
+            return MulAdd(column_3, Lane<3>(factors), result);
+        }
+    }
+}
+
+#endif
\ No newline at end of file
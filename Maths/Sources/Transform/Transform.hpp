@@ -0,0 +1,85 @@
+#pragma once
+
+#include "../Quaternion/Quaternion.hpp"
+
+namespace Maths
+{
+    /**
+     * Translation, rotation and scaling kept apart, 10 floats instead of 16.
+     * The matrix is TranslationMatrix(translation) * rotation.ToMatrix() * ScalingMatrix(scaling).
+     * Composition and inversion are exact as long as the scaling is uniform,
+     * a non uniform scaling followed by a rotation can't be represented as a TRS anymore.
+     */
+    class Transform
+    {
+        public :
+
+            Vector3 translation;
+            Quaternion rotation;
+            Vector3 scaling;
+
+            /// Identity transformation
+            constexpr Transform() : translation(), rotation(), scaling(1.0f, 1.0f, 1.0f) {}
+            constexpr Transform(Vector3 const& translation, Quaternion const& rotation, Vector3 const& scaling = {1.0f, 1.0f, 1.0f})
+                : translation(translation), rotation(rotation), scaling(scaling) {}
+
+            /// Composition, the result applies other first then this
+            constexpr Transform operator*(Transform const& other) const
+            {
+                return { this->translation + this->rotation * (this->scaling * other.translation), this->rotation * other.rotation, this->scaling * other.scaling };
+            }
+
+            /// Transform a point
+            constexpr Vector3 operator*(Vector3 const& point) const { return this->translation + this->rotation * (this->scaling * point); }
+
+            constexpr Transform Inverse() const
+            {
+                Vector3 inverse_scaling = 1.0f / this->scaling;
+                Quaternion inverse_rotation = this->rotation.Conjugate();
+                return { -(inverse_scaling * (inverse_rotation * this->translation)), inverse_rotation, inverse_scaling };
+            }
+
+            /// Same result as the product of the 3 matrices, without any matrix product
+            inline Matrix4x4 ToMatrix() const
+            {
+                Matrix4x4 result = this->rotation.ToMatrix();
+                for(uint8_t column=0; column<3; column++)
+                    for(uint8_t row=0; row<3; row++)
+                        result[column * 4 + row] *= this->scaling[column];
+                result.SetTranslation(this->translation);
+                return result;
+            }
+
+            /// Split a matrix without shear into translation, rotation and scaling
+            static inline Transform FromMatrix(Matrix4x4 const& matrix)
+            {
+                Vector3 scaling(
+                    Vector3(matrix[0], matrix[1], matrix[2]).Length(),
+                    Vector3(matrix[4], matrix[5], matrix[6]).Length(),
+                    Vector3(matrix[8], matrix[9], matrix[10]).Length()
+                );
+
+                Matrix4x4 rotation;
+                for(uint8_t column=0; column<3; column++)
+                    for(uint8_t row=0; row<3; row++)
+                        rotation[column * 4 + row] = matrix[column * 4 + row] / scaling[column];
+
+                return { matrix.GetTranslation(), Quaternion::FromMatrix(rotation), scaling };
+            }
+
+            /**
+             * Interpolate each component, the rotation uses Slerp
+             * @param source Transformation at ratio 0
+             * @param dest Transformation at ratio 1
+             * @param ratio Progression between 0 and 1
+             */
+            static inline Transform Interpolate(Transform const& source, Transform const& dest, float ratio)
+            {
+                return {
+                    source.translation + (dest.translation - source.translation) * ratio,
+                    Quaternion::Slerp(source.rotation, dest.rotation, ratio),
+                    source.scaling + (dest.scaling - source.scaling) * ratio
+                };
+            }
+    };
+}
\ No newline at end of file
@@ -1,186 +1,220 @@
-#include <memory>
+#pragma once
+
 #include <array>
 #include <cmath>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include "../Simd/Simd.hpp"
 
 #if !defined(DEGREES_TO_RADIANS)
 #define DEGREES_TO_RADIANS 0.01745329251994329576923690768489f
 #endif
 
-#if defined VEC_TYPE
-#undef VEC_TYPE
-#endif
+namespace Maths
+{
+    /**
+     * Named components of a vector, one specialization per size.
+     * Components are plain members rather than a union with an array, so that vectors can be read in constant expressions.
+     */
+    template<typename T, size_t N> class VectorComponents;
 
-#if VECTOR_N == 2 && !defined(VEC_TYPE_2)
-#define VEC_TYPE Vector2
-#define VEC_TYPE_2
-#elif VECTOR_N == 3 && !defined(VEC_TYPE_3)
-#define VEC_TYPE Vector3
-#define VEC_TYPE_3
-#elif VECTOR_N == 4 && !defined(VEC_TYPE_4)
-#define VEC_TYPE Vector4
-#define VEC_TYPE_4
-#else
-#undef VECTOR_N
-#endif
+    template<typename T> class VectorComponents<T, 2>
+    {
+        public :
+            T x;
+            T y;
 
-#if defined(VEC_TYPE)
+            constexpr VectorComponents() : x(), y() {}
+            constexpr VectorComponents(T x, T y) : x(x), y(y) {}
+
+        protected :
+            constexpr T& Component(size_t index) { return index == 0 ? this->x : this->y; }
+            constexpr T const& Component(size_t index) const { return index == 0 ? this->x : this->y; }
+    };
+
+    template<typename T> class VectorComponents<T, 3>
+    {
+        public :
+            T x;
+            T y;
+            T z;
+
+            constexpr VectorComponents() : x(), y(), z() {}
+            constexpr VectorComponents(T x, T y, T z) : x(x), y(y), z(z) {}
+
+        protected :
+            constexpr T& Component(size_t index) { return index == 0 ? this->x : index == 1 ? this->y : this->z; }
+            constexpr T const& Component(size_t index) const { return index == 0 ? this->x : index == 1 ? this->y : this->z; }
+    };
+
+    template<typename T> class VectorComponents<T, 4>
+    {
+        public :
+            T x;
+            T y;
+            T z;
+            T w;
+
+            constexpr VectorComponents() : x(), y(), z(), w() {}
+            constexpr VectorComponents(T x, T y, T z, T w) : x(x), y(y), z(z), w(w) {}
+
+        protected :
+            constexpr T& Component(size_t index) { return index == 0 ? this->x : index == 1 ? this->y : index == 2 ? this->z : this->w; }
+            constexpr T const& Component(size_t index) const { return index == 0 ? this->x : index == 1 ? this->y : index == 2 ? this->z : this->w; }
+    };
 
-namespace Maths
-{
     /**
      * Vertex class definition (vec2, vec3, vec4)
+     * Every operation is constexpr except the ones relying on <cmath>
      */
-    class VEC_TYPE
+    template<typename T, size_t N>
+    class Vector : public VectorComponents<T, N>
     {
-        public :
+        private :
 
-            union
-            {
-                struct 
-                {
-                    float x;
-                    float y;
-                    #if VECTOR_N > 2
-                    float z;
-                    #endif
-                    #if VECTOR_N > 3
-                    float w;
-                    #endif
-                };
-                
-                #if VECTOR_N == 2
-                std::array<float, 2> xy;
-                #elif VECTOR_N == 3
-                std::array<float, 3> xyz;
-                #elif VECTOR_N == 4
-                std::array<float, 4> xyzw;
-                #endif
-                std::array<float, VECTOR_N> value;
-            };
+            template<typename U, size_t... I>
+            constexpr Vector(std::array<U, N> const& list, std::index_sequence<I...>) : VectorComponents<T, N>(static_cast<T>(list[I])...) {}
 
-            /// Initialization to zero
-            inline VEC_TYPE() : value({}) {}
+            template<size_t M, size_t... I>
+            constexpr Vector(Vector<T, M> const& other, std::index_sequence<I...>) : VectorComponents<T, N>(other[I]...) {}
 
-            /// Copy list initializer
-            inline VEC_TYPE(std::array<float, VECTOR_N> const& list) : value(list) {}
+            /// std::min and std::max are not function objects
+            /// @{
+            struct MINIMUM { constexpr T operator()(T const a, T const b) const { return b < a ? b : a; } };
+            struct MAXIMUM { constexpr T operator()(T const a, T const b) const { return a < b ? b : a; } };
+            /// @}
 
-            /// Move list initializer
-            inline VEC_TYPE(std::array<float, VECTOR_N>&& list) : value(std::move(list)) {}
+            /// Component wise operation on a vector
+            template<typename OPERATION, size_t... I>
+            static constexpr Vector Apply(Vector const& a, OPERATION operation, std::index_sequence<I...>) { return Vector(operation(a[I])...); }
 
-            /// Copy constructor
-            inline VEC_TYPE(VEC_TYPE const& other) : value(other.value) {}
+            /// Component wise operation between two vectors
+            template<typename OPERATION, size_t... I>
+            static constexpr Vector Apply(Vector const& a, Vector const& b, OPERATION operation, std::index_sequence<I...>) { return Vector(operation(a[I], b[I])...); }
 
-            /// Move constructor
-            inline VEC_TYPE(VEC_TYPE&& other) : value(std::move(other.value)) {}
+            /// Component wise operation between a vector and a scalar
+            template<typename OPERATION, size_t... I>
+            static constexpr Vector Apply(Vector const& a, T b, OPERATION operation, std::index_sequence<I...>) { return Vector(operation(a[I], b)...); }
 
-            /// Constructor from double values
-            inline VEC_TYPE(std::array<double, VECTOR_N> value) { for(uint8_t i=0;i<VECTOR_N;i++) this->value[i] = static_cast<float>(value[i]); }
+            /// Component wise operation between a scalar and a vector
+            template<typename OPERATION, size_t... I>
+            static constexpr Vector Apply(T a, Vector const& b, OPERATION operation, std::index_sequence<I...>) { return Vector(operation(a, b[I])...); }
+
+        public :
+
+            /// Initialization to zero
+            constexpr Vector() : VectorComponents<T, N>() {}
 
             /// Explicit values constructor
+            using VectorComponents<T, N>::VectorComponents;
+
+            /// List initializer
+            constexpr Vector(std::array<T, N> const& list) : Vector(list, std::make_index_sequence<N>()) {}
+
+            /// Constructor from double values
+            template<typename U = T, typename = typename std::enable_if<!std::is_same<U, double>::value>::type>
+            constexpr Vector(std::array<double, N> const& list) : Vector(list, std::make_index_sequence<N>()) {}
+
+            /// A Vector4 can be used as a Vector3
+            template<size_t M, typename = typename std::enable_if<M == 4 && N == 3>::type>
+            constexpr Vector(Vector<T, M> const& other) : Vector(other, std::make_index_sequence<N>()) {}
+
+            /// Conversion from and to a SIMD register, Vector4 only
             /// {@
-            #if VECTOR_N == 2
-            inline VEC_TYPE(float x, float y) : x(x), y(y) {}
-            #elif VECTOR_N == 3
-            inline VEC_TYPE(float x, float y, float z) : x(x), y(y), z(z) {}
-            #elif VECTOR_N == 4
-            inline VEC_TYPE(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+            #if defined(MATHS_SIMD)
+            inline explicit Vector(Simd::FLOAT4 value)
+            {
+                static_assert(N == 4 && std::is_same<T, float>::value, "Only Vector4 maps to a SIMD register");
+                Simd::StoreUnaligned(&this->x, value);
+            }
+
+            inline Simd::FLOAT4 ToSimd() const
+            {
+                static_assert(N == 4 && std::is_same<T, float>::value, "Only Vector4 maps to a SIMD register");
+                return Simd::LoadUnaligned(&this->x);
+            }
             #endif
             /// @}
 
-            /// Get reference or Set Vector3[i]
-            inline float& operator[](uint32_t index){ return this->value[index]; }
-
-            /// Get const Vector3[i]
-            inline float operator[](uint32_t index) const { return this->value[index]; }
-
-            /// Copy assignment
-            inline VEC_TYPE& operator=(VEC_TYPE const& other) { if(this != &other) this->value = other.value; return *this; }
+            /// Get reference or Set Vector[i]
+            constexpr T& operator[](size_t index){ return this->Component(index); }
 
-            /// Move assignment
-            inline VEC_TYPE& operator=(VEC_TYPE&& other) { if(this != &other) this->value = std::move(other.value); return *this; }
+            /// Get const Vector[i]
+            constexpr T const& operator[](size_t index) const { return this->Component(index); }
 
             /// Equality operator
-            inline bool operator==(VEC_TYPE const& other) const { return this->value == other.value; }
+            constexpr bool operator==(Vector const& other) const
+            {
+                for(size_t i=0; i<N; i++) if((*this)[i] != other[i]) return false;
+                return true;
+            }
 
             /// Inequality operator
-            inline bool operator!=(VEC_TYPE const& other) const { return this->value != other.value; }
+            constexpr bool operator!=(Vector const& other) const { return !(*this == other); }
 
             /// Base math operator
             /// @{
-            #if VECTOR_N == 2
-            inline VEC_TYPE operator*(VEC_TYPE const& other) const { return { this->x * other.x, this->y * other.y }; }
-            inline VEC_TYPE operator*(float const scalar) const { return { this->x * scalar, this->y * scalar }; }
-            inline VEC_TYPE operator/(float const scalar) const { return { this->x / scalar, this->y / scalar }; }
-            inline VEC_TYPE operator+(VEC_TYPE const& other) const { return { this->x + other.x, this->y + other.y }; }
-            inline VEC_TYPE operator-(VEC_TYPE const& other) const { return { this->x - other.x, this->y - other.y }; }
-            inline VEC_TYPE operator-() const { return {-this->x, -this->y}; }
-            inline float Length() const { return std::sqrt(this->x * this->x + this->y * this->y); }
-            #elif VECTOR_N == 3
-            inline VEC_TYPE operator*(VEC_TYPE const& other) const { return { this->x * other.x, this->y * other.y, this->z * other.z }; }
-            inline VEC_TYPE operator*(float const scalar) const { return { this->x * scalar, this->y * scalar, this->z * scalar }; }
-            inline VEC_TYPE operator/(float const scalar) const { return { this->x / scalar, this->y / scalar, this->z / scalar }; }
-            inline VEC_TYPE operator+(VEC_TYPE const& other) const { return { this->x + other.x, this->y + other.y, this->z + other.z }; }
-            inline VEC_TYPE operator-(VEC_TYPE const& other) const { return { this->x - other.x, this->y - other.y, this->z - other.z }; }
-            inline VEC_TYPE operator-() const { return { -this->x, -this->y, -this->z }; }
-            inline float Length() const { return std::sqrt(this->x * this->x + this->y * this->y + this->z * this->z); }
-            inline float Dot(VEC_TYPE const& other) const { return this->x * other.x + this->y * other.y + this->z * other.z; }
-            inline VEC_TYPE Cross(VEC_TYPE const& other) const { return {this->y * other.z - other.y * this->z, this->z * other.x - other.z * this->x, this->x * other.y - other.x * this->y }; }
-            static inline VEC_TYPE Min(VEC_TYPE const& a, VEC_TYPE const& b){ return { std::min<float>(a.x, b.x), std::min<float>(a.y, b.y), std::min<float>(a.z, b.z) }; }
-            static inline VEC_TYPE Max(VEC_TYPE const& a, VEC_TYPE const& b){ return { std::max<float>(a.x, b.x), std::max<float>(a.y, b.y), std::max<float>(a.z, b.z) }; }
-            #elif VECTOR_N == 4
-            inline VEC_TYPE operator*(VEC_TYPE const& other) const { return { this->x * other.x, this->y * other.y, this->z * other.z, this->w * other.w }; }
-            inline VEC_TYPE operator*(float const scalar) const { return { this->x * scalar, this->y * scalar, this->z * scalar, this->w * scalar }; }
-            inline VEC_TYPE& operator/=(float const scalar) { this->x /= scalar; this->y /= scalar; this->z /= scalar; this->w /= scalar; return *this; }
-            inline VEC_TYPE operator/(float const scalar) const { return { this->x / scalar, this->y / scalar, this->z / scalar, this->w / scalar }; }
-            inline VEC_TYPE operator+(VEC_TYPE const& other) const { return { this->x + other.x, this->y + other.y, this->z + other.z, this->w + other.w }; }
-            inline VEC_TYPE operator-(VEC_TYPE const& other) const { return { this->x - other.x, this->y - other.y, this->z - other.z, this->w + other.w }; }
-            inline VEC_TYPE operator-() const { return { -this->x, -this->y, -this->z, -this->w }; }
-            inline float Length() const { return std::sqrt(this->x * this->x + this->y * this->y + this->z * this->z + this->w * this->w); }
-            #endif
+            constexpr Vector operator*(Vector const& other) const { return Vector::Apply(*this, other, std::multiplies<T>(), std::make_index_sequence<N>()); }
+            constexpr Vector operator*(T const scalar) const { return Vector::Apply(*this, scalar, std::multiplies<T>(), std::make_index_sequence<N>()); }
+            constexpr Vector operator/(T const scalar) const { return Vector::Apply(*this, scalar, std::divides<T>(), std::make_index_sequence<N>()); }
+            constexpr Vector operator+(Vector const& other) const { return Vector::Apply(*this, other, std::plus<T>(), std::make_index_sequence<N>()); }
+            constexpr Vector operator-(Vector const& other) const { return Vector::Apply(*this, other, std::minus<T>(), std::make_index_sequence<N>()); }
+            constexpr Vector operator-() const { return Vector::Apply(*this, std::negate<T>(), std::make_index_sequence<N>()); }
+            constexpr Vector& operator/=(T const scalar) { return *this = *this / scalar; }
+
+            constexpr T Dot(Vector const& other) const
+            {
+                T result = T();
+                for(size_t i=0; i<N; i++) result += (*this)[i] * other[i];
+                return result;
+            }
+
+            constexpr Vector Cross(Vector const& other) const
+            {
+                static_assert(N == 3, "Cross product is only defined for Vector3");
+                return { (*this)[1] * other[2] - other[1] * (*this)[2], (*this)[2] * other[0] - other[2] * (*this)[0], (*this)[0] * other[1] - other[0] * (*this)[1] };
+            }
+
+            static constexpr Vector Min(Vector const& a, Vector const& b) { return Vector::Apply(a, b, MINIMUM(), std::make_index_sequence<N>()); }
+            static constexpr Vector Max(Vector const& a, Vector const& b) { return Vector::Apply(a, b, MAXIMUM(), std::make_index_sequence<N>()); }
+
+            inline T Length() const { return std::sqrt(this->Dot(*this)); }
             /// @}
 
             /// Set vector length to 1
-            VEC_TYPE Normalize() const { return *this / this->Length(); }
+            inline Vector Normalize() const { return *this / this->Length(); }
 
             /// Convert vector components from degrees to radians
-            inline VEC_TYPE ToRadians() const { return *this * DEGREES_TO_RADIANS; }
-            
+            constexpr Vector ToRadians() const { return *this * static_cast<T>(DEGREES_TO_RADIANS); }
+
             /// Compute the interpolated value between source and dest vector using ratio
-            static inline VEC_TYPE Interpolate(VEC_TYPE const& source, VEC_TYPE const& dest, float ratio)
+            static inline Vector Interpolate(Vector const& source, Vector const& dest, T ratio)
             {
-                VEC_TYPE result;
-                for(uint8_t i=0; i<VECTOR_N; i++) {
+                Vector result;
+                for(size_t i=0; i<N; i++) {
                     if(source[i] <= dest[i]) result[i] = source[i] + std::abs(dest[i] - source[i]) * ratio;
                     else result[i] = source[i] - std::abs(dest[i] - source[i]) * ratio;
                 }
                 return result;
             }
 
-            #if defined(VEC_TYPE_4) && VECTOR_N == 3
-            inline Vector3& operator=(Vector4 const& other) { this->value = {other.x, other.y, other.z}; return *this; }
-            inline Vector3(Vector4 const& other) : value({other.x, other.y, other.z}) {}
-            #endif
+            /// Scalar on the left side
+            /// @{
+            friend constexpr Vector operator/(T const scalar, Vector const& vector) { return Vector::Apply(scalar, vector, std::divides<T>(), std::make_index_sequence<N>()); }
+            friend constexpr Vector operator*(T const scalar, Vector const& vector) { return Vector::Apply(scalar, vector, std::multiplies<T>(), std::make_index_sequence<N>()); }
+            friend constexpr Vector operator-(T const scalar, Vector const& vector) { return Vector::Apply(scalar, vector, std::minus<T>(), std::make_index_sequence<N>()); }
+            friend constexpr Vector operator+(T const scalar, Vector const& vector) { return Vector::Apply(scalar, vector, std::plus<T>(), std::make_index_sequence<N>()); }
+            /// @}
 
             // std::unique_ptr<char> Serialize() const;
             // size_t Deserialize(const char* data);
     };
 
-    /// Base math operator
-    /// @{
-    #if VECTOR_N == 2
-    inline VEC_TYPE operator/(float const scalar, VEC_TYPE const& vector) { return { scalar / vector.x, scalar / vector.y }; }
-    inline VEC_TYPE operator*(float const scalar, VEC_TYPE const& vector) { return { scalar * vector.x, scalar * vector.y }; }
-    #elif VECTOR_N == 3
-    inline VEC_TYPE operator/(float const scalar, VEC_TYPE const& vector) { return { scalar / vector.x, scalar / vector.y, scalar / vector.z }; }
-    inline VEC_TYPE operator*(float const scalar, VEC_TYPE const& vector) { return { scalar * vector.x, scalar * vector.y, scalar * vector.z }; }
-    inline VEC_TYPE operator-(float const scalar, VEC_TYPE const& vector) { return { scalar - vector.x, scalar - vector.y, scalar - vector.z }; }
-    inline VEC_TYPE operator+(float const scalar, VEC_TYPE const& vector) { return { scalar + vector.x, scalar + vector.y, scalar + vector.z }; }
-    #elif VECTOR_N == 4
-    inline VEC_TYPE operator/(float const scalar, VEC_TYPE const& vector) { return { scalar / vector.x, scalar / vector.y, scalar / vector.z, scalar / vector.w }; }
-    inline VEC_TYPE operator*(float const scalar, VEC_TYPE const& vector) { return { scalar * vector.x, scalar * vector.y, scalar * vector.z, scalar * vector.w }; }
-    #endif
-    /// @}
-}
-
-#undef VECTOR_N
-#endif
\ No newline at end of file
+    typedef Vector<float, 2> Vector2;
+    typedef Vector<float, 3> Vector3;
+    typedef Vector<float, 4> Vector4;
+}
\ No newline at end of file